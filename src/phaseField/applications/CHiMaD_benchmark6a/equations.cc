@@ -88,7 +88,8 @@ variable_list.set_scalar_gradient_term_RHS(0,eqx_c);
 // "q_point_loc". The function outputs two terms to variable_list -- one proportional
 // to the test function and one proportional to the gradient of the test function. The
 // index for each variable in this list corresponds to the index given at the top of
-// this file.
+// this file. It is called separately for each of these equations, and the index of
+// the field being updated can be accessed by "this->currentFieldIndex".
 
 template <int dim, int degree>
 void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
@@ -97,11 +98,13 @@ void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,
  // --- Getting the values and derivatives of the model variables ---
 
  scalarvalueType c = variable_list.get_scalar_value(0);
+
+ if (this->currentFieldIndex == 1){
+
  scalargradType cx = variable_list.get_scalar_gradient(0);
 
- // The electric potential and its derivatives
+ // The electric potential
  scalarvalueType phi = variable_list.get_scalar_value(2);
- scalargradType phix = variable_list.get_scalar_gradient(2);
 
  // --- Setting the expressions for the terms in the governing equations ---
 
@@ -113,17 +116,29 @@ void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,
 
  scalarvalueType eq_mu = fcV+fphiV;
  scalargradType eqx_mu = constV(KcV)*cx;
- scalarvalueType eq_phi = -constV(-k/epsilon)*c;
- scalargradType eqx_phi = -phix;
 
  // --- Submitting the terms for the governing equations ---
 
  variable_list.set_scalar_value_term_RHS(1,eq_mu);
  variable_list.set_scalar_gradient_term_RHS(1,eqx_mu);
 
+ }
+ else if (this->currentFieldIndex == 2){
+
+ // The gradient of the electric potential
+ scalargradType phix = variable_list.get_scalar_gradient(2);
+
+ // --- Setting the expressions for the terms in the governing equations ---
+
+ scalarvalueType eq_phi = -constV(-k/epsilon)*c;
+ scalargradType eqx_phi = -phix;
+
+ // --- Submitting the terms for the governing equations ---
+
  variable_list.set_scalar_value_term_RHS(2,eq_phi);
  variable_list.set_scalar_gradient_term_RHS(2,eqx_phi);
 
+ }
 
 }
 
@@ -4,7 +4,7 @@ template <int dim, int degree>
 class customPDE: public MatrixFreePDE<dim,degree>
 {
 public:
-	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(_userInputs) {
+	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(MatrixFreePDE<dim,degree>::userInputs) {
 		c_dependent_misfit = false;
 		for (unsigned int i=0; i<dim; i++){
 			for (unsigned int j=0; j<dim; j++){
@@ -23,7 +23,7 @@ public:
 private:
     #include "../../include/typeDefs.h"
 
-    const userInputParameters<dim> userInputs;
+    const userInputParameters<dim> & userInputs;
 
     // Function to set the RHS of the governing equations for explicit time dependent equations (in equations.h)
     void explicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
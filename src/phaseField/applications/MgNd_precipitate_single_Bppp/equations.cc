@@ -44,7 +44,7 @@ void variableAttributeLoader::loadVariableAttributes(){
 	set_variable_equation_type		(3,TIME_INDEPENDENT);
 
     set_dependencies_value_term_RHS(3, "");
-    set_dependencies_gradient_term_RHS(3, "n1, grad(u)");
+    set_dependencies_gradient_term_RHS(3, "c, n1, grad(u)");
     set_dependencies_value_term_LHS(3, "");
     set_dependencies_gradient_term_LHS(3, "n1, grad(change(u))");
 
@@ -210,7 +210,8 @@ variable_list.set_scalar_gradient_term_RHS(2,eqx_n1);
 // "q_point_loc". The function outputs two terms to variable_list -- one proportional
 // to the test function and one proportional to the gradient of the test function. The
 // index for each variable in this list corresponds to the index given at the top of
-// this file.
+// this file. It is called separately for each of these equations, and the index of
+// the field being updated can be accessed by "this->currentFieldIndex".
 
 template <int dim, int degree>
 void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
@@ -298,16 +299,7 @@ void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,
  }
 
 
- vectorgradType eqx_u;
-
- // Fill residual corresponding to mechanics
- // R=-C*(E-E0)
-
- for (unsigned int i=0; i<dim; i++){
- for (unsigned int j=0; j<dim; j++){
- 	  eqx_u[i][j] = - S[i][j];
- }
- }
+ if (this->currentFieldIndex == 1){
 
  scalarvalueType mu_c = constV(0.0);
  mu_c += facV*cacV * (constV(1.0)-h1V) + fbcV*cbcV * h1V;
@@ -317,14 +309,32 @@ void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,
  	}
  }
 
-
  scalarvalueType eq_mu = (mu_c);
 
  // --- Submitting the terms for the governing equations ---
 
  variable_list.set_scalar_value_term_RHS(1,eq_mu);
+
+ }
+ else {
+
+ vectorgradType eqx_u;
+
+ // Fill residual corresponding to mechanics
+ // R=-C*(E-E0)
+
+ for (unsigned int i=0; i<dim; i++){
+ for (unsigned int j=0; j<dim; j++){
+ 	  eqx_u[i][j] = - S[i][j];
+ }
+ }
+
+ // --- Submitting the terms for the governing equations ---
+
  variable_list.set_vector_gradient_term_RHS(3,eqx_u);
 
+ }
+
 }
 
 // =============================================================================================
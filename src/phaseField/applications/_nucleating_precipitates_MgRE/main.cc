@@ -30,10 +30,12 @@ int main (int argc, char **argv)
 
     // Parse the command line options (if there are any) to get the name of the input file
     std::string parameters_filename;
+    unsigned int number_of_threads;
     try
     {
         ParseCommandLineOpts cli_options(argc, argv);
         parameters_filename = cli_options.getParametersFilename();
+        number_of_threads = cli_options.getNumberOfThreads();
     }
     catch(const char* msg){
         std::cerr << std::endl << std::endl
@@ -59,6 +61,11 @@ int main (int argc, char **argv)
         variableAttributeLoader variable_attributes;
         inputFileReader input_file_reader(parameters_filename,variable_attributes);
 
+        // A thread count given on the command line takes precedence over the one in the input file
+        if (number_of_threads > 0){
+            input_file_reader.parameter_handler.set("Number of threads per process",(long int)number_of_threads);
+        }
+
         // Continue based on the number of dimensions and degree of the elements specified in the input file
         switch (input_file_reader.number_of_dimensions)
         {
@@ -0,0 +1,123 @@
+// =================================================================================
+// Set the attributes of the primary field variables
+// =================================================================================
+// This function sets attributes for each variable/equation in the app. The
+// attributes are set via standardized function calls. The first parameter for each
+// function call is the variable index (starting at zero). The first set of
+// variable/equation attributes are the variable name (any string), the variable
+// type (SCALAR/VECTOR), and the equation type (EXPLICIT_TIME_DEPENDENT/
+// IMPLICIT_TIME_DEPENDENT/TIME_INDEPENDENT/AUXILIARY). The next set of attributes describe the
+// dependencies for the governing equation on the values and derivatives of the
+// other variables for the value term and gradient term of the RHS and the LHS.
+// The final pair of attributes determine whether a variable represents a field
+// that can nucleate and whether the value of the field is needed for nucleation
+// rate calculations.
+
+void variableAttributeLoader::loadVariableAttributes(){
+	// Variable 0
+	set_variable_name				(0,"n");
+	set_variable_type				(0,SCALAR);
+	set_variable_equation_type		(0,IMPLICIT_TIME_DEPENDENT);
+
+    // The driving force is evaluated with the value of "n" at the start of the time
+    // step, "old(n)", so the equation for the change in "n" is linear and only one
+    // linear solve is needed per time step
+    set_dependencies_value_term_RHS(0, "n, old(n)");
+    set_dependencies_gradient_term_RHS(0, "grad(n)");
+    set_dependencies_value_term_LHS(0, "change(n)");
+    set_dependencies_gradient_term_LHS(0, "grad(change(n))");
+
+}
+
+// =============================================================================================
+// explicitEquationRHS (needed only if one or more equation is explict time dependent)
+// =============================================================================================
+// This function calculates the right-hand-side of the explicit time-dependent
+// equations for each variable. It takes "variable_list" as an input, which is a list
+// of the value and derivatives of each of the variables at a specific quadrature
+// point. The (x,y,z) location of that quadrature point is given by "q_point_loc".
+// The function outputs two terms to variable_list -- one proportional to the test
+// function and one proportional to the gradient of the test function. The index for
+// each variable in this list corresponds to the index given at the top of this file.
+
+template <int dim, int degree>
+void customPDE<dim,degree>::explicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
+				 dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+
+}
+
+// =============================================================================================
+// nonExplicitEquationRHS (needed only if one or more equation is time independent or auxiliary)
+// =============================================================================================
+// This function calculates the right-hand-side of all of the equations that are not
+// explicit time-dependent equations. It takes "variable_list" as an input, which is
+// a list of the value and derivatives of each of the variables at a specific
+// quadrature point. The (x,y,z) location of that quadrature point is given by
+// "q_point_loc". The function outputs two terms to variable_list -- one proportional
+// to the test function and one proportional to the gradient of the test function. The
+// index for each variable in this list corresponds to the index given at the top of
+// this file.
+
+template <int dim, int degree>
+void customPDE<dim,degree>::nonExplicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
+				 dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+
+// --- Getting the values and derivatives of the model variables ---
+
+// The order parameter and its derivatives
+scalarvalueType n = variable_list.get_scalar_value(0);
+scalargradType nx = variable_list.get_scalar_gradient(0);
+
+// The order parameter at the start of the time step
+scalarvalueType n_old = variable_list.get_old_scalar_value(0);
+
+// --- Setting the expressions for the terms in the governing equations ---
+
+// Linearly stabilized IMEX scheme: the gradient term is implicit, the driving force
+// is explicit, and the stabilization term SnV*(n-n_old) damps the explicit part
+scalarvalueType fnV = (4.0*n_old*(n_old-1.0)*(n_old-0.5));
+scalarvalueType eq_n = -(constV(1.0+userInputs.dtValue*MnV*SnV)*(n-n_old) + constV(userInputs.dtValue*MnV)*fnV);
+scalargradType eqx_n = (-constV(userInputs.dtValue*KnV*MnV)*nx);
+
+// --- Submitting the terms for the governing equations ---
+
+variable_list.set_scalar_value_term_RHS(0,eq_n);
+variable_list.set_scalar_gradient_term_RHS(0,eqx_n);
+
+}
+
+// =============================================================================================
+// equationLHS (needed only if at least one equation is time independent)
+// =============================================================================================
+// This function calculates the left-hand-side of time-independent equations. It
+// takes "variable_list" as an input, which is a list of the value and derivatives of
+// each of the variables at a specific quadrature point. The (x,y,z) location of that
+// quadrature point is given by "q_point_loc". The function outputs two terms to
+// variable_list -- one proportional to the test function and one proportional to the
+// gradient of the test function -- for the left-hand-side of the equation. The index
+// for each variable in this list corresponds to the index given at the top of this
+// file. If there are multiple elliptic equations, conditional statements should be
+// sed to ensure that the correct residual is being submitted. The index of the field
+// being solved can be accessed by "this->currentFieldIndex".
+
+template <int dim, int degree>
+void customPDE<dim,degree>::equationLHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
+		dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {
+
+// --- Getting the values and derivatives of the model variables ---
+
+// The change in the order parameter and its derivatives
+scalarvalueType Dn = variable_list.get_change_in_scalar_value(0);
+scalargradType Dnx = variable_list.get_change_in_scalar_gradient(0);
+
+// --- Setting the expressions for the terms in the governing equations ---
+
+scalarvalueType eq_Dn = (constV(1.0+userInputs.dtValue*MnV*SnV)*Dn);
+scalargradType eqx_Dn = (constV(userInputs.dtValue*KnV*MnV)*Dnx);
+
+// --- Submitting the terms for the governing equations ---
+
+variable_list.set_scalar_value_term_LHS(0,eq_Dn);
+variable_list.set_scalar_gradient_term_LHS(0,eqx_Dn);
+
+}
@@ -4,7 +4,7 @@ template <int dim, int degree>
 class customPDE: public MatrixFreePDE<dim,degree>
 {
 public:
-	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(_userInputs) {};
+	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(MatrixFreePDE<dim,degree>::userInputs) {};
     // Function to set the initial conditions (in ICs_and_BCs.h)
     void setInitialCondition(const dealii::Point<dim> &p, const unsigned int index, double & scalar_IC, dealii::Vector<double> & vector_IC);
 
@@ -14,7 +14,7 @@ public:
     private:
     #include "../../include/typeDefs.h"
 
-    const userInputParameters<dim> userInputs;
+    const userInputParameters<dim> & userInputs;
 
     // Function to set the RHS of the governing equations for explicit time dependent equations (in equations.h)
     void explicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
@@ -4,7 +4,7 @@ template <int dim, int degree>
 class customPDE: public MatrixFreePDE<dim,degree>
 {
 public:
-	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(_userInputs) {
+	customPDE(userInputParameters<dim> _userInputs): MatrixFreePDE<dim,degree>(_userInputs) , userInputs(MatrixFreePDE<dim,degree>::userInputs) {
 		c_dependent_misfit = false;
 		for (unsigned int i=0; i<dim; i++){
 			for (unsigned int j=0; j<dim; j++){
@@ -31,7 +31,7 @@ public:
 private:
     #include "../../include/typeDefs.h"
 
-    const userInputParameters<dim> userInputs;
+    const userInputParameters<dim> & userInputs;
 
     // Function to set the RHS of the governing equations for explicit time dependent equations (in equations.h)
     void explicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
@@ -158,20 +158,40 @@ void customPDE<dim,degree>::solve(){
         this->currentIncrement++;
 
         // Cycle up to the proper output and checkpoint counters
-        while (this->userInputs.outputTimeStepList.size() > 0 && this->userInputs.outputTimeStepList[this->currentOutput] < this->currentIncrement){
-            this->currentOutput++;
+        if (this->userInputs.adaptive_time_stepping){
+            while (this->currentOutput < this->userInputs.outputTimeList.size() && this->userInputs.outputTimeList[this->currentOutput] < this->currentTime){
+                this->currentOutput++;
+            }
+            while (this->currentCheckpoint < this->userInputs.checkpointTimeList.size() && this->userInputs.checkpointTimeList[this->currentCheckpoint] < this->currentTime){
+                this->currentCheckpoint++;
+            }
         }
-        while (this->userInputs.checkpointTimeStepList.size() > 0 && this->userInputs.checkpointTimeStepList[this->currentCheckpoint] < this->currentIncrement){
-            this->currentCheckpoint++;
+        else {
+            while (this->userInputs.outputTimeStepList.size() > 0 && this->userInputs.outputTimeStepList[this->currentOutput] < this->currentIncrement){
+                this->currentOutput++;
+            }
+            while (this->userInputs.checkpointTimeStepList.size() > 0 && this->userInputs.checkpointTimeStepList[this->currentCheckpoint] < this->currentIncrement){
+                this->currentCheckpoint++;
+            }
         }
 
+        // The declared stable time step is for the smallest cell of the mesh at the start of the time stepping
+        this->updateStableTimeStep();
+
         //time stepping
-        this->pcout << "\nTime stepping parameters: timeStep: " << this->userInputs.dtValue << "  timeFinal: " << this->userInputs.finalTime << "  timeIncrements: " << this->userInputs.totalIncrements << "\n";
+        if (this->userInputs.adaptive_time_stepping){
+            this->pcout << "\nTime stepping parameters (adaptive): initial timeStep: " << this->userInputs.dtValue << "  timeFinal: " << this->userInputs.finalTime << "  tolerance: " << this->userInputs.adaptive_time_step_tolerance << "\n";
+        }
+        else {
+            this->pcout << "\nTime stepping parameters: timeStep: " << this->userInputs.dtValue << "  timeFinal: " << this->userInputs.finalTime << "  timeIncrements: " << this->userInputs.totalIncrements << "\n";
+        }
 
         // This is the main time-stepping loop
-        for (; this->currentIncrement<=this->userInputs.totalIncrements; ++this->currentIncrement){
+        // With adaptive time stepping, the loop runs until the final time instead of for a set number of increments
+        for (; !this->timeSteppingComplete(); ++this->currentIncrement){
 
             //increment current time
+            this->setTimeStepForNextIncrement();
             this->currentTime+=this->userInputs.dtValue;
             if (this->currentIncrement%userInputs.skip_print_steps==0){
                 this->pcout << "\ntime increment:" << this->currentIncrement << "  time: " << this->currentTime << "\n";
@@ -190,8 +210,14 @@ void customPDE<dim,degree>::solve(){
             //solve time increment
             solveIncrement(false);
 
+            // With adaptive time stepping, the increment is solved again with a shorter time step while its error
+            // estimate is over the tolerance
+            while (this->rejectAdaptiveTimeStep()){
+                solveIncrement(false);
+            }
+
             // Output results to file (on the proper increments)
-            if (this->userInputs.outputTimeStepList[this->currentOutput] == this->currentIncrement) {
+            if (this->scheduledEventDue(this->userInputs.outputTimeStepList, this->userInputs.outputTimeList, this->currentOutput)) {
 
                 for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
                     this->constraintsDirichletSet[fieldIndex]->distribute(*this->solutionSet[fieldIndex]);
@@ -208,7 +234,13 @@ void customPDE<dim,degree>::solve(){
                 if (n_ouputs_so_far > 1){
                     if (abs(list_of_integrated_postprocessed_fields[n_ouputs_so_far-2][0] - list_of_integrated_postprocessed_fields[n_ouputs_so_far-1][0]) < equilbrium_tol){
                         if (n_ouputs_so_far < this->userInputs.outputTimeStepList.size()-1){
-                            this->currentIncrement = this->userInputs.outputTimeStepList[this->currentOutput]-1;
+                            // With adaptive time stepping the outputs are scheduled by time, so jump ahead in time instead
+                            if (this->userInputs.adaptive_time_stepping){
+                                this->currentTime = this->userInputs.outputTimeList[this->currentOutput]-this->nominal_dtValue;
+                            }
+                            else {
+                                this->currentIncrement = this->userInputs.outputTimeStepList[this->currentOutput]-1;
+                            }
                         }
 
                     }
@@ -216,11 +248,14 @@ void customPDE<dim,degree>::solve(){
             }
 
             // Create a checkpoint (on the proper increments)
-            if (this->userInputs.checkpointTimeStepList[this->currentCheckpoint] == this->currentIncrement) {
+            if (this->scheduledEventDue(this->userInputs.checkpointTimeStepList, this->userInputs.checkpointTimeList, this->currentCheckpoint)) {
                 this->save_checkpoint();
                 this->currentCheckpoint++;
             }
 
+            // Choose the time step for the next increment (if adaptive time stepping is enabled)
+            this->updateAdaptiveTimeStep();
+
         }
     }
 
@@ -250,9 +285,39 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
     Timer time;
     char buffer[200];
 
-    // Get the RHS of the explicit equations
+    // Keep the solution of the implicit time-dependent fields from the start of the time step
+    if (!skip_time_dependent){
+        this->storeOldSolution();
+    }
+
+    // Get the RHS of the explicit equations and update all of the explicit fields in a single pass
     if (this->hasExplicitEquation && !skip_time_dependent){
         this->computeExplicitRHS();
+
+        if (!integrated_c_before_set){
+            dt_modifier = 0.0;
+        }
+        else{
+            dt_modifier = 1.0;
+        }
+
+        // The integral of c before the first update is the target for the mass conservation correction below
+        if (this->fields[0].pdetype==EXPLICIT_TIME_DEPENDENT && !integrated_c_before_set){
+            this->computeIntegralMF(integrated_c_before, 0, this->solutionSet);
+            integrated_c_before_set = true;
+        }
+
+        // Advance the subcycled explicit fields through their substeps first, so the RHS of each substep sees the other
+        // explicit fields at the start of the time step (their residuals from the first RHS are kept until they're updated)
+        this->updateSubcycledExplicitFields();
+
+        std::vector<unsigned int> explicit_field_indices;
+        for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+            if (this->fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT && userInputs.var_explicit_subcycling_steps[fieldIndex] == 1){
+                explicit_field_indices.push_back(fieldIndex);
+            }
+        }
+        this->updateExplicitSolution(explicit_field_indices);
     }
 
 
@@ -260,34 +325,9 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
     for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
         this->currentFieldIndex = fieldIndex; // Used in computeLHS()
 
-        // Add Neumann BC terms to the residual vector for the current field, if appropriate
-        // Currently commented out because it isn't working yet
-        //applyNeumannBCs();
-
         //Parabolic (first order derivatives in time) fields
         if (this->fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT && !skip_time_dependent){
 
-            double nominal_dt;
-			if (!integrated_c_before_set){
-				dt_modifier = 0.0;
-			}
-			else{
-				dt_modifier = 1.0;
-			}
-
-			if (fieldIndex == 0 && !integrated_c_before_set){
-				this->computeIntegralMF(integrated_c_before, fieldIndex, this->solutionSet);
-                                integrated_c_before_set = true;
-			}
-
-            // Explicit-time step each DOF
-            // Takes advantage of knowledge that the length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
-            unsigned int invM_size = this->invM.local_size();
-            for (unsigned int dof=0; dof<this->solutionSet[fieldIndex]->local_size(); ++dof){
-                this->solutionSet[fieldIndex]->local_element(dof)=			\
-                this->invM.local_element(dof%invM_size)*this->residualSet[fieldIndex]->local_element(dof);
-            }
-
             if (fieldIndex == 0){
 				this->constraintsOtherSet[fieldIndex]->distribute(*(this->solutionSet[fieldIndex]));
 				this->constraintsDirichletSet[fieldIndex]->distribute(*(this->solutionSet[fieldIndex]));
@@ -311,9 +351,9 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
             if (this->has_Dirichlet_BCs){
                 this->constraintsDirichletSet[fieldIndex]->distribute(*this->solutionSet[fieldIndex]);
             }
-            //computing_timer.enter_section("matrixFreePDE: updateExplicitGhosts");
-            this->solutionSet[fieldIndex]->update_ghost_values();
-            //computing_timer.exit_section("matrixFreePDE: updateExplicitGhosts");
+            // The ghost values are now out of date. They aren't exchanged here: the cell loop of the next explicit RHS
+            // starts the exchange itself and processes the interior cells while it completes.
+            this->solutionSet[fieldIndex]->zero_out_ghosts();
 
             // Print update to screen and confirm that solution isn't nan
             if (this->currentIncrement%userInputs.skip_print_steps==0){
@@ -337,26 +377,63 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
     }
 
-    // Now, update the non-explicit variables
-    // For the time being, this is just the elliptic equations, but implicit parabolic and auxilary equations should also be here
+    // Now, update the non-explicit variables (the implicit time-dependent, time-independent, and auxiliary equations)
     if (this->hasNonExplicitEquation){
 
-        bool nonlinear_it_converged = false;
+        // Keep the solution at the start of the time step for the extrapolated initial guesses of the linear solves
+        if (!skip_time_dependent){
+            this->storeSolutionForChangeHistory();
+        }
+
+        // Time-independent fields whose dependencies have barely changed since their last solve keep their last solution
+        std::vector<bool> reuse_solution(this->fields.size(),false);
+        bool nonexplicit_solve_needed = false;
+        for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+            if (this->fields[fieldIndex].pdetype == TIME_INDEPENDENT && !skip_time_dependent){
+                reuse_solution[fieldIndex] = this->reuseLastSolution(fieldIndex);
+            }
+            if (this->fields[fieldIndex].pdetype != EXPLICIT_TIME_DEPENDENT && !reuse_solution[fieldIndex]){
+                nonexplicit_solve_needed = true;
+            }
+        }
+
+        // The LHS cell loops read the solution of the other fields without exchanging their ghost values, so the
+        // explicit fields need theirs before the nonexplicit fields are solved
+        if (nonexplicit_solve_needed && this->hasExplicitEquation && !skip_time_dependent){
+            for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+                if (this->fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT){
+                    this->solutionSet[fieldIndex]->update_ghost_values();
+                }
+            }
+        }
+
+        bool nonlinear_it_converged = !nonexplicit_solve_needed;
         unsigned int nonlinear_it_index = 0;
 
+        // The Anderson acceleration only mixes the iterates of the current solve
+        std::fill(this->andersonIterateCount.begin(), this->andersonIterateCount.end(), 0);
+
         while (!nonlinear_it_converged){
             nonlinear_it_converged = true; // Set to true here and will be set to false if any variable isn't converged
 
-            // Update residualSet for the non-explicitly updated variables
-            //compute_nonexplicit_RHS()
-            // Ideally, I'd just do this for the non-explicit variables, but for now I'll do all of them
-            // this is a little redundant, but hopefully not too terrible
-            this->computeNonexplicitRHS();
-
             for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
                 this->currentFieldIndex = fieldIndex; // Used in computeLHS()
 
-                if ( (this->fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || this->fields[fieldIndex].pdetype == TIME_INDEPENDENT){
+                if ( ((this->fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || this->fields[fieldIndex].pdetype == TIME_INDEPENDENT) && !reuse_solution[fieldIndex]
+                    && userInputs.var_nonlinear[fieldIndex] && MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getSolverType(fieldIndex) == NEWTON_KRYLOV){
+
+                    // Take one inexact Newton step for this field
+                    bool newton_converged = this->solveNewtonKrylovStep(fieldIndex, nonlinear_it_index, (nonlinear_it_index == 0 && !skip_time_dependent));
+
+                    if (!newton_converged && nonlinear_it_index < MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getMaxIterations()){
+                        nonlinear_it_converged = false;
+                    }
+                }
+                else if ( ((this->fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || this->fields[fieldIndex].pdetype == TIME_INDEPENDENT) && !reuse_solution[fieldIndex]
+                    && (userInputs.var_nonlinear[fieldIndex] || nonlinear_it_index == 0)){
+
+                    // Update the residual of this field (the fields solved before it in this iteration are already updated)
+                    this->computeNonexplicitRHS(fieldIndex);
 
                     if (this->currentIncrement%userInputs.skip_print_steps==0 && userInputs.var_nonlinear[fieldIndex]){
                         sprintf(buffer, "field '%2s' [nonlinear solve]: current solution: %12.6e, current residual:%12.6e\n", \
@@ -366,16 +443,10 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         this->pcout<<buffer;
                     }
 
-                    dealii::parallel::distributed::Vector<double> solution_diff = *this->solutionSet[fieldIndex];
-
                     //apply Dirichlet BC's
                     // Loops through all DoF to which ones have Dirichlet BCs applied, replace the ones that do with the Dirichlet value
                     // This clears the residual where we want to apply Dirichlet BCs, otherwise the solver sees a positive residual
-                    for (std::map<types::global_dof_index, double>::const_iterator it=this->valuesDirichletSet[fieldIndex]->begin(); it!=this->valuesDirichletSet[fieldIndex]->end(); ++it){
-                        if (this->residualSet[fieldIndex]->in_local_range(it->first)){
-                            (*this->residualSet[fieldIndex])(it->first) = 0.0;
-                        }
-                    }
+                    this->zeroDirichletDoFs(*this->residualSet[fieldIndex], fieldIndex);
 
                     //solver controls
                     double tol_value;
@@ -388,23 +459,8 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
                     SolverControl solver_control(MatrixFreePDE<dim,degree>::userInputs.linear_solver_parameters.getMaxIterations(fieldIndex), tol_value);
 
-                    // Currently the only allowed solver is SolverCG, the SolverType input variable is a dummy
-                    SolverCG<vectorType> solver(solver_control);
-
                     //solve
-                    try{
-                        if (this->fields[fieldIndex].type == SCALAR){
-                            this->dU_scalar=0.0;
-                            solver.solve(*this, this->dU_scalar, *this->residualSet[fieldIndex], IdentityMatrix(this->solutionSet[fieldIndex]->size()));
-                        }
-                        else {
-                            this->dU_vector=0.0;
-                            solver.solve(*this, this->dU_vector, *this->residualSet[fieldIndex], IdentityMatrix(this->solutionSet[fieldIndex]->size()));
-                        }
-                    }
-                    catch (...) {
-                        this->pcout << "\nWarning: implicit solver did not converge as per set tolerances. consider increasing maxSolverIterations or decreasing solverTolerance.\n";
-                    }
+                    this->solveLinearSystem(fieldIndex, solver_control, (nonlinear_it_index == 0 && !skip_time_dependent));
 
                     if (userInputs.var_nonlinear[fieldIndex]){
 
@@ -412,7 +468,6 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         double damping_coefficient;
 
                         if (MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getBacktrackDampingFlag(fieldIndex)){
-                            vectorType solutionSet_old = *this->solutionSet[fieldIndex];
                             double residual_old = this->residualSet[fieldIndex]->l2_norm();
 
                             damping_coefficient = 1.0;
@@ -425,13 +480,9 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                                     this->solutionSet[fieldIndex]->sadd(1.0,damping_coefficient,this->dU_vector);
                                 }
 
-                                this->computeNonexplicitRHS();
+                                this->computeNonexplicitRHS(fieldIndex);
 
-                                for (std::map<types::global_dof_index, double>::const_iterator it=this->valuesDirichletSet[fieldIndex]->begin(); it!=this->valuesDirichletSet[fieldIndex]->end(); ++it){
-                                    if (this->residualSet[fieldIndex]->in_local_range(it->first)){
-                                        (*this->residualSet[fieldIndex])(it->first) = 0.0;
-                                    }
-                                }
+                                this->zeroDirichletDoFs(*this->residualSet[fieldIndex], fieldIndex);
 
                                 double residual_new = this->residualSet[fieldIndex]->l2_norm();
 
@@ -444,8 +495,14 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                                     damping_coefficient_found = true;
                                 }
                                 else{
+                                    // Undo the rejected step in place instead of keeping a copy of the old solution
+                                    if (this->fields[fieldIndex].type == SCALAR){
+                                        this->solutionSet[fieldIndex]->add(-damping_coefficient,this->dU_scalar);
+                                    }
+                                    else {
+                                        this->solutionSet[fieldIndex]->add(-damping_coefficient,this->dU_vector);
+                                    }
                                     damping_coefficient *= MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getBacktrackStepModifier(fieldIndex);
-                                    *this->solutionSet[fieldIndex] = solutionSet_old;
                                 }
                             }
                         }
@@ -499,32 +556,28 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         }
                     }
                     else {
-                        if (nonlinear_it_index ==0){
+                        if (this->fields[fieldIndex].type == SCALAR){
+                            *this->solutionSet[fieldIndex] += this->dU_scalar;
+                        }
+                        else {
+                            *this->solutionSet[fieldIndex] += this->dU_vector;
+                        }
 
+                        if (this->currentIncrement%userInputs.skip_print_steps==0){
+                            double dU_norm;
                             if (this->fields[fieldIndex].type == SCALAR){
-                                *this->solutionSet[fieldIndex] += this->dU_scalar;
+                                dU_norm = this->dU_scalar.l2_norm();
                             }
                             else {
-                                *this->solutionSet[fieldIndex] += this->dU_vector;
-                            }
-
-                            if (this->currentIncrement%userInputs.skip_print_steps==0){
-                                double dU_norm;
-                                if (this->fields[fieldIndex].type == SCALAR){
-                                    dU_norm = this->dU_scalar.l2_norm();
-                                }
-                                else {
-                                    dU_norm = this->dU_vector.l2_norm();
-                                }
-                                sprintf(buffer, "field '%2s' [implicit solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, tolerance criterion:%12.6e, solution: %12.6e, dU: %12.6e\n", \
-                                this->fields[fieldIndex].name.c_str(),			\
-                                this->residualSet[fieldIndex]->l2_norm(),			\
-                                solver_control.last_value(),				\
-                                solver_control.last_step(), solver_control.tolerance(), this->solutionSet[fieldIndex]->l2_norm(), dU_norm);
-                                this->pcout<<buffer;
+                                dU_norm = this->dU_vector.l2_norm();
                             }
+                            sprintf(buffer, "field '%2s' [implicit solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, tolerance criterion:%12.6e, solution: %12.6e, dU: %12.6e\n", \
+                            this->fields[fieldIndex].name.c_str(),			\
+                            this->residualSet[fieldIndex]->l2_norm(),			\
+                            solver_control.last_value(),				\
+                            solver_control.last_step(), solver_control.tolerance(), this->solutionSet[fieldIndex]->l2_norm(), dU_norm);
+                            this->pcout<<buffer;
                         }
-
                     }
                 }
                 else if (this->fields[fieldIndex].pdetype == AUXILIARY){
@@ -541,13 +594,9 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                             }
                         }
 
-                        // Explicit-time step each DOF
-                        // Takes advantage of knowledge that the length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
-                        unsigned int invM_size = this->invM.local_size();
-                        for (unsigned int dof=0; dof<this->solutionSet[fieldIndex]->local_size(); ++dof){
-                            this->solutionSet[fieldIndex]->local_element(dof)=			\
-                            this->invM.local_element(dof%invM_size)*this->residualSet[fieldIndex]->local_element(dof);
-                        }
+                        // Update the residual of this field and explicit-time step each DOF
+                        this->computeNonexplicitRHS(fieldIndex);
+                        this->updateExplicitSolution(std::vector<unsigned int>(1,fieldIndex));
 
                         // Set the Dirichelet values (hanging node constraints don't need to be distributed every time step, only at output)
                         this->constraintsDirichletSet[fieldIndex]->distribute(*this->solutionSet[fieldIndex]);
@@ -582,6 +631,13 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
                                 if (diff > MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getToleranceValue(fieldIndex) && nonlinear_it_index < MatrixFreePDE<dim,degree>::userInputs.nonlinear_solver_parameters.getMaxIterations()){
                                     nonlinear_it_converged = false;
+
+                                    // Mix the new iterate with the previous ones for the next iteration
+                                    if (this->andersonHistorySet[fieldIndex].size() > 0){
+                                        this->applyAndersonAcceleration(fieldIndex);
+                                        this->constraintsDirichletSet[fieldIndex]->distribute(*this->solutionSet[fieldIndex]);
+                                        this->solutionSet[fieldIndex]->update_ghost_values();
+                                    }
                                 }
 
                             }
@@ -604,6 +660,16 @@ void customPDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
             nonlinear_it_index++;
         }
+
+        for(unsigned int fieldIndex=0; fieldIndex<this->fields.size(); fieldIndex++){
+            if (this->fields[fieldIndex].pdetype == TIME_INDEPENDENT && !reuse_solution[fieldIndex]){
+                this->storeLastSolve(fieldIndex);
+            }
+        }
+
+        if (!skip_time_dependent){
+            this->updateSolutionChangeHistory();
+        }
     }
 
     if (this->currentIncrement%userInputs.skip_print_steps==0){
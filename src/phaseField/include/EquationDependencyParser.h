@@ -28,7 +28,10 @@ public:
 
 
     // All of the vectors of flags for what is needed for the solution variables
-    std::vector<bool> need_value_explicit_RHS, need_gradient_explicit_RHS, need_hessian_explicit_RHS, need_value_nonexplicit_RHS, need_gradient_nonexplicit_RHS, need_hessian_nonexplicit_RHS, need_value_nonexplicit_LHS, need_gradient_nonexplicit_LHS, need_hessian_nonexplicit_LHS, need_value_change_nonexplicit_LHS, need_gradient_change_nonexplicit_LHS, need_hessian_change_nonexplicit_LHS, need_value_residual_explicit_RHS, need_gradient_residual_explicit_RHS, need_value_residual_nonexplicit_RHS, need_gradient_residual_nonexplicit_RHS, need_value_residual_nonexplicit_LHS, need_gradient_residual_nonexplicit_LHS;
+    std::vector<bool> need_value_explicit_RHS, need_gradient_explicit_RHS, need_hessian_explicit_RHS, need_value_nonexplicit_RHS, need_gradient_nonexplicit_RHS, need_hessian_nonexplicit_RHS, need_value_old_nonexplicit_RHS, need_value_nonexplicit_LHS, need_gradient_nonexplicit_LHS, need_hessian_nonexplicit_LHS, need_value_change_nonexplicit_LHS, need_gradient_change_nonexplicit_LHS, need_hessian_change_nonexplicit_LHS, need_value_residual_explicit_RHS, need_gradient_residual_explicit_RHS, need_value_residual_nonexplicit_RHS, need_gradient_residual_nonexplicit_RHS, need_value_residual_nonexplicit_LHS, need_gradient_residual_nonexplicit_LHS;
+
+    // The flags for what is needed by each non-explicit equation on its own, indexed by the equation and then by the variable (all false for the explicit equations)
+    std::vector<std::vector<bool> > eq_need_value_nonexplicit_RHS, eq_need_gradient_nonexplicit_RHS, eq_need_hessian_nonexplicit_RHS, eq_need_value_old_nonexplicit_RHS, eq_need_value_nonexplicit_LHS, eq_need_gradient_nonexplicit_LHS, eq_need_hessian_nonexplicit_LHS, eq_need_value_change_nonexplicit_LHS, eq_need_gradient_change_nonexplicit_LHS, eq_need_hessian_change_nonexplicit_LHS;
 
     // All of the vectors of flags for what is needed for the postprocessing variables
     std::vector<bool> pp_need_value, pp_need_gradient, pp_need_hessian, pp_need_value_residual, pp_need_gradient_residual;
@@ -36,9 +39,9 @@ public:
 
 protected:
     /**
-    * Method to parse the RHS dependency strings and populate the vectors for whether values, gradients, or hessians are needed.
+    * Method to parse the RHS dependency strings and populate the vectors for whether values, gradients, hessians, or old values are needed.
     */
-    void parseDependencyListRHS(std::vector<std::string> var_name, std::vector<PDEType> var_eq_type, unsigned int var_index, std::string value_dependencies, std::string gradient_dependencies, std::vector<bool> & need_value, std::vector<bool> & need_gradient, std::vector<bool> & need_hessian, bool & need_value_residual, bool & need_gradient_residual, bool & is_nonlinear);
+    void parseDependencyListRHS(std::vector<std::string> var_name, std::vector<PDEType> var_eq_type, unsigned int var_index, std::string value_dependencies, std::string gradient_dependencies, std::vector<bool> & need_value, std::vector<bool> & need_gradient, std::vector<bool> & need_hessian, std::vector<bool> & need_value_old, bool & need_value_residual, bool & need_gradient_residual, bool & is_nonlinear);
 
     /**
     * Method to parse the LHS dependency strings and populate the vectors for whether values, gradients, or hessians are needed.
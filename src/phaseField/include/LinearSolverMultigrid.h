@@ -0,0 +1,112 @@
+#ifndef INCLUDE_LINEARSOLVERMULTIGRID_H_
+#define INCLUDE_LINEARSOLVERMULTIGRID_H_
+
+#include <deal.II/base/config.h>
+
+// The matrix-free multigrid classes used here are only available in deal.II version 9.0 and later
+#if (DEAL_II_VERSION_MAJOR >= 9)
+
+#include <vector>
+#include <memory>
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/lac/parallel_vector.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/multigrid.h>
+
+template <int dim, int degree> class MatrixFreePDE;
+
+/**
+* This is a class for the LHS operator on one level of the multigrid hierarchy. It applies the user's equationLHS
+* (through the MatrixFreePDE object) on the level MatrixFree object, using the solution interpolated to the level
+* for LHS that depend on the solution. The Dirichlet DOFs and the DOFs on the refinement edges are handled by the
+* deal.II base class.
+*/
+template <int dim, int degree>
+class LevelLHSOperator: public dealii::MatrixFreeOperators::Base<dim,dealii::parallel::distributed::Vector<double> >
+{
+public:
+    typedef dealii::parallel::distributed::Vector<double> VectorType;
+
+    LevelLHSOperator(): pde(NULL), level_solution_set(NULL) {};
+
+    /**
+    * Method to set the PDE object that supplies equationLHS and the solution vectors on this level.
+    */
+    void set_pde(const MatrixFreePDE<dim,degree> * _pde, const std::vector<VectorType*> * _level_solution_set){
+        pde = _pde;
+        level_solution_set = _level_solution_set;
+    };
+
+    /**
+    * Method to compute the inverse of the diagonal of the level operator (used by the Chebyshev smoother).
+    */
+    virtual void compute_diagonal();
+
+private:
+    virtual void apply_add(VectorType &dst, const VectorType &src) const;
+
+    void local_apply(const dealii::MatrixFree<dim,double> &data,
+        VectorType &dst,
+        const VectorType &src,
+        const std::pair<unsigned int,unsigned int> &cell_range) const;
+
+    void local_compute_diagonal(const dealii::MatrixFree<dim,double> &data,
+        VectorType &dst,
+        const VectorType &src,
+        const std::pair<unsigned int,unsigned int> &cell_range) const;
+
+    const MatrixFreePDE<dim,degree> * pde;
+    const std::vector<VectorType*> * level_solution_set;
+};
+
+/**
+* This is a class that holds the geometric multigrid hierarchy for one field: the level constraints and transfer for
+* each field on the mesh levels, the level MatrixFree objects, the level operators, the Chebyshev smoothers, and the
+* V-cycle and preconditioner that CG applies. The hierarchy is built once for each mesh and reused for every solve.
+* The members are declared so that the objects that refer to others are destroyed first.
+*/
+template <int dim, int degree>
+class LinearSolverMultigrid
+{
+public:
+    typedef dealii::parallel::distributed::Vector<double> VectorType;
+    typedef dealii::PreconditionChebyshev<LevelLHSOperator<dim,degree>,VectorType> SmootherType;
+
+    // The level Dirichlet DOFs and refinement edges, and the transfer between the levels, for each field (NULL for fields not needed on the levels)
+    std::vector<std::shared_ptr<dealii::MGConstrainedDoFs> > mg_constrained_dofs;
+    std::vector<std::shared_ptr<dealii::MGTransferMatrixFree<dim,double> > > transfers;
+
+    // The MatrixFree object for each level, with the DOF handlers of all of the fields
+    dealii::MGLevelObject<std::shared_ptr<dealii::MatrixFree<dim,double> > > level_matrix_free;
+
+    // The solution of each field interpolated to each level and the pointers to them passed to equationLHS (NULL for fields not needed in the LHS)
+    std::vector<dealii::MGLevelObject<VectorType> > level_solutions;
+    dealii::MGLevelObject<std::vector<VectorType*> > level_solution_set;
+
+    // The LHS operators on each level and their restrictions to the refinement edges
+    dealii::MGLevelObject<LevelLHSOperator<dim,degree> > level_operators;
+    dealii::MGLevelObject<dealii::MatrixFreeOperators::MGInterfaceOperator<LevelLHSOperator<dim,degree> > > interface_operators;
+
+    // The Chebyshev smoothers on each level (on the coarsest level the Chebyshev iteration is run to convergence)
+    dealii::mg::SmootherRelaxation<SmootherType,VectorType> smoother;
+    dealii::MGCoarseGridApplySmoother<VectorType> coarse;
+
+    // The level and refinement edge matrices, the V-cycle (which keeps its level vectors between the cycles), and the
+    // preconditioner that applies it to the vectors on the active mesh
+    std::shared_ptr<dealii::mg::Matrix<VectorType> > mg_matrix;
+    std::shared_ptr<dealii::mg::Matrix<VectorType> > mg_interface;
+    std::shared_ptr<dealii::Multigrid<VectorType> > mg_cycle;
+    std::shared_ptr<dealii::PreconditionMG<dim, VectorType, dealii::MGTransferMatrixFree<dim,double> > > preconditioner;
+};
+
+#endif
+
+#endif
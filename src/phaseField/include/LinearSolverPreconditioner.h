@@ -0,0 +1,150 @@
+#ifndef INCLUDE_LINEARSOLVERPRECONDITIONER_H_
+#define INCLUDE_LINEARSOLVERPRECONDITIONER_H_
+
+#include <vector>
+#include <algorithm>
+#include "SolverParameters.h"
+
+/**
+* This is a class for the Jacobi and Chebyshev preconditioners for the matrix-free linear solves. Both only need the
+* inverse of the diagonal of the LHS and the vmult of the matrix-free operator, so no matrix is ever assembled. The
+* Chebyshev preconditioner applies a fixed number of Chebyshev iterations on the Jacobi-preconditioned system starting
+* from zero, which is a fixed polynomial in the operator and thus can be used with CG. The inverse diagonal may be
+* stored in lower precision than the vectors (DiagonalVectorType), the products are still computed in double precision.
+*
+* The preconditioner only refers to the matrix, the inverse diagonal and the two work vectors of the Chebyshev
+* iterations (which the caller owns), so one object can be kept for each field and reused for every solve.
+*/
+template <typename MatrixType, typename VectorType, typename DiagonalVectorType=VectorType>
+class LinearSolverPreconditioner
+{
+public:
+    LinearSolverPreconditioner():
+        matrix(NULL),
+        inverse_diagonal(NULL),
+        residual(NULL),
+        update(NULL),
+        preconditioner_type(JACOBI),
+        chebyshev_degree(1),
+        chebyshev_smoothing_range(1.0),
+        max_eigenvalue(1.0),
+        min_eigenvalue(1.0){};
+
+    LinearSolverPreconditioner(const MatrixType &_matrix,
+        const DiagonalVectorType &_inverse_diagonal,
+        LinearSolverPreconditionerType _preconditioner_type,
+        unsigned int _chebyshev_degree,
+        double _max_eigenvalue,
+        double _chebyshev_smoothing_range):
+        residual(NULL),
+        update(NULL){
+
+            initialize(_matrix, _inverse_diagonal, _preconditioner_type, _chebyshev_degree, _chebyshev_smoothing_range);
+            set_max_eigenvalue(_max_eigenvalue);
+        };
+
+    /**
+    * Method to set the operator, the inverse diagonal and the type of the preconditioner.
+    */
+    void initialize(const MatrixType &_matrix,
+        const DiagonalVectorType &_inverse_diagonal,
+        LinearSolverPreconditionerType _preconditioner_type,
+        unsigned int _chebyshev_degree,
+        double _chebyshev_smoothing_range){
+
+            matrix = &_matrix;
+            inverse_diagonal = &_inverse_diagonal;
+            preconditioner_type = _preconditioner_type;
+            chebyshev_degree = _chebyshev_degree;
+            chebyshev_smoothing_range = _chebyshev_smoothing_range;
+        };
+
+    /**
+    * Method to set the work vectors for the Chebyshev iterations (with the layout of the solved field). They are
+    * only used inside vmult(), so they can be shared with other temporary uses outside of the linear solve.
+    */
+    void set_work_vectors(VectorType &_residual, VectorType &_update){
+        residual = &_residual;
+        update = &_update;
+    };
+
+    /**
+    * Method to set the estimate of the largest eigenvalue of the Jacobi-preconditioned operator that bounds the
+    * Chebyshev polynomial.
+    */
+    void set_max_eigenvalue(double _max_eigenvalue){
+        // The upper bound gets a safety factor since the eigenvalue estimate is from below
+        max_eigenvalue = 1.2*_max_eigenvalue;
+        min_eigenvalue = max_eigenvalue/chebyshev_smoothing_range;
+    };
+
+    /**
+    * Method to apply the preconditioner, dst = P^{-1} src.
+    */
+    void vmult(VectorType &dst, const VectorType &src) const {
+
+        // Jacobi step (also the first Chebyshev step, scaled below)
+        for (unsigned int i=0; i<dst.local_size(); i++){
+            dst.local_element(i) = (double)inverse_diagonal->local_element(i)*src.local_element(i);
+        }
+
+        if (preconditioner_type != CHEBYSHEV){
+            return;
+        }
+
+        const double theta = 0.5*(max_eigenvalue + min_eigenvalue);
+        const double delta = 0.5*(max_eigenvalue - min_eigenvalue);
+        const double sigma = theta/delta;
+        double rho_old = 1.0/sigma;
+
+        *update = dst;
+        *update *= 1.0/theta;
+        dst = *update;
+
+        for (unsigned int k=1; k<chebyshev_degree; k++){
+            // The Jacobi-preconditioned residual for the current iterate
+            matrix->vmult(*residual, dst);
+            residual->sadd(-1.0, 1.0, src);
+            for (unsigned int i=0; i<residual->local_size(); i++){
+                residual->local_element(i) *= (double)inverse_diagonal->local_element(i);
+            }
+
+            double rho = 1.0/(2.0*sigma - rho_old);
+            update->sadd(rho*rho_old, 2.0*rho/delta, *residual);
+            dst += *update;
+            rho_old = rho;
+        }
+    };
+
+private:
+    const MatrixType *matrix;
+    const DiagonalVectorType *inverse_diagonal;
+
+    // Work vectors for the Chebyshev iterations (owned by the caller)
+    VectorType *residual, *update;
+
+    LinearSolverPreconditionerType preconditioner_type;
+    unsigned int chebyshev_degree;
+    double chebyshev_smoothing_range;
+    double max_eigenvalue, min_eigenvalue;
+};
+
+/**
+* This is a functor to record the largest eigenvalue estimated by SolverCG (used to bound the Chebyshev polynomial).
+*/
+class MaxEigenvalueRecorder
+{
+public:
+    MaxEigenvalueRecorder(double &_max_eigenvalue): max_eigenvalue(_max_eigenvalue) {};
+
+    void operator()(const std::vector<double> &eigenvalues) const {
+        if (eigenvalues.size() > 0){
+            max_eigenvalue = *std::max_element(eigenvalues.begin(),eigenvalues.end());
+        }
+    };
+
+private:
+    double &max_eigenvalue;
+};
+
+#endif
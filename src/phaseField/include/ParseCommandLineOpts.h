@@ -6,6 +6,7 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 #include <deal.II/base/mpi.h>
 
 class ParseCommandLineOpts{
@@ -14,46 +15,66 @@ class ParseCommandLineOpts{
             argc = _argc;
             for (int i=1; i < argc; ++i)
                 tokens.push_back(std::string(argv[i]));
-        }
-
-        std::string getParametersFilename(){
-            std::string parameters_filename;
 
-            if (argc == 3){
-                if (cmdOptionExists("-i")){
-                    parameters_filename = getCmdOption("-i");
-                    if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
-                        std::cout << "Using the input parameter file: " << parameters_filename << std::endl;
+            // Check that only the allowed options were given
+            for (unsigned int i=0; i < tokens.size(); ++i){
+                if (tokens[i] == "-i"){
+                    // The input file name is optional
+                    if (i+1 < tokens.size() && tokens[i+1][0] != '-'){
+                        ++i;
                     }
                 }
-                else {
-                    throw("Invalid command line option given. The only argument should be to specify the input file name.");
-                }
-            }
-            else if (argc == 2){
-                if (cmdOptionExists("-i")){
-                    parameters_filename = "parameters.in";
-                    if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
-                        std::cout << "Using the input parameter file: " << parameters_filename << std::endl;
+                else if (tokens[i] == "-t"){
+                    // The number of threads is required
+                    if (i+1 < tokens.size() && tokens[i+1][0] != '-'){
+                        ++i;
+                    }
+                    else {
+                        throw("The '-t' command line option must be followed by the number of threads per process.");
                     }
                 }
                 else {
-                    throw("Invalid command line option given. The only argument should be to specify the input file name.");
+                    throw("Invalid command line option given. The allowed arguments are '-i' to specify the input file name and '-t' to specify the number of threads per process.");
                 }
             }
-            else if (argc == 1){
-                parameters_filename = "parameters.in";
-                if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
-                    std::cout << "Using the input parameter file: " << parameters_filename << std::endl;
+        }
+
+        std::string getParametersFilename(){
+            std::string parameters_filename = "parameters.in";
+
+            if (cmdOptionExists("-i")){
+                std::string option_value = getCmdOption("-i");
+                if (option_value.size() > 0 && option_value[0] != '-'){
+                    parameters_filename = option_value;
                 }
             }
-            else {
-                throw("Too many command line arguments were given. The only argument should be to specify the input file name.");
+
+            if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
+                std::cout << "Using the input parameter file: " << parameters_filename << std::endl;
             }
 
             return parameters_filename;
         }
 
+        // Returns the number of threads per process given with '-t', or zero if the option wasn't given
+        unsigned int getNumberOfThreads(){
+            unsigned int number_of_threads = 0;
+
+            if (cmdOptionExists("-t")){
+                int option_value = std::atoi(getCmdOption("-t").c_str());
+                if (option_value < 1){
+                    throw("The number of threads per process given with '-t' must be a positive integer.");
+                }
+                number_of_threads = option_value;
+
+                if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
+                    std::cout << "Using " << number_of_threads << " thread(s) per process (set on the command line)" << std::endl;
+                }
+            }
+
+            return number_of_threads;
+        }
+
     private:
         int argc;
         std::vector <std::string> tokens;
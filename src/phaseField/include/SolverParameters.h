@@ -6,6 +6,14 @@
 
 enum SolverToleranceType {ABSOLUTE_RESIDUAL,RELATIVE_RESIDUAL_CHANGE,ABSOLUTE_SOLUTION_CHANGE};
 
+enum LinearSolverPreconditionerType {NO_PRECONDITIONER,JACOBI,CHEBYSHEV,MULTIGRID};
+
+enum PreconditionerPrecisionType {DOUBLE_PRECISION,SINGLE_PRECISION};
+
+enum LinearSolverInitialGuessType {ZERO_INITIAL_GUESS,PREVIOUS_CHANGE,LINEAR_EXTRAPOLATION,QUADRATIC_EXTRAPOLATION};
+
+enum NonlinearSolverType {DAMPED_ITERATION,NEWTON_KRYLOV};
+
 /**
 * This is a base class that holds parameters related to a numerical solver (either linear or nonlinear)
 * As in many other PRISMS-PF classes,
@@ -53,16 +61,66 @@ public:
     void loadParameters(unsigned int _var_index,
                         SolverToleranceType _tolerance_type,
                         double _tolerance_value,
-                        unsigned int _max_iterations);
+                        unsigned int _max_iterations,
+                        LinearSolverPreconditionerType _preconditioner_type=NO_PRECONDITIONER,
+                        unsigned int _chebyshev_degree=5,
+                        double _chebyshev_smoothing_range=20.0,
+                        LinearSolverInitialGuessType _initial_guess_type=ZERO_INITIAL_GUESS,
+                        unsigned int _solve_interval=1,
+                        double _solve_change_threshold=0.0,
+                        PreconditionerPrecisionType _preconditioner_precision=DOUBLE_PRECISION);
 
     /**
     * Method to get the maximum number of allowed iterations for the linear solver.
     */
     unsigned int getMaxIterations(unsigned int index);
 
+    /**
+    * Method to get the preconditioner type for the linear solver.
+    */
+    LinearSolverPreconditionerType getPreconditionerType(unsigned int index);
+
+    /**
+    * Method to get the degree of the Chebyshev polynomial (used with the Chebyshev preconditioner and as the multigrid smoother).
+    */
+    unsigned int getChebyshevDegree(unsigned int index);
+
+    /**
+    * Method to get the ratio between the largest and smallest eigenvalues targeted by the Chebyshev preconditioner (or smoother).
+    */
+    double getChebyshevSmoothingRange(unsigned int index);
+
+    /**
+    * Method to get how the initial guess for the change in the solution is set for the first linear solve of each time step.
+    */
+    LinearSolverInitialGuessType getInitialGuessType(unsigned int index);
+
+    /**
+    * Method to get the maximum number of increments between the solves of a time-independent field (1 solves it every increment).
+    */
+    unsigned int getSolveInterval(unsigned int index);
+
+    /**
+    * Method to get the largest change in the fields a time-independent field depends on for which its solve is skipped (0 turns the check off).
+    */
+    double getSolveChangeThreshold(unsigned int index);
+
+    /**
+    * Method to get the precision the inverse of the LHS diagonal is stored in for the Jacobi and Chebyshev preconditioners.
+    * The fields themselves are always stored in double precision.
+    */
+    PreconditionerPrecisionType getPreconditionerPrecision(unsigned int index);
+
 protected:
 
     std::vector<unsigned int> max_iterations_list;
+    std::vector<LinearSolverPreconditionerType> preconditioner_type_list;
+    std::vector<unsigned int> chebyshev_degree_list;
+    std::vector<double> chebyshev_smoothing_range_list;
+    std::vector<LinearSolverInitialGuessType> initial_guess_type_list;
+    std::vector<unsigned int> solve_interval_list;
+    std::vector<double> solve_change_threshold_list;
+    std::vector<PreconditionerPrecisionType> preconditioner_precision_list;
 
 };
 
@@ -97,7 +155,12 @@ public:
                         double _backtrack_step_modifier,
                         double _backtrack_residual_decrease_coeff,
                         double _default_dampling_coefficient,
-                        bool _laplace_for_initial_guess);
+                        bool _laplace_for_initial_guess,
+                        NonlinearSolverType _solver_type=DAMPED_ITERATION,
+                        double _initial_forcing_term=0.1,
+                        double _max_forcing_term=0.9,
+                        double _armijo_coeff=1.0e-4,
+                        unsigned int _anderson_depth=0);
 
     /**
     * Method to get the backtrack line-search damping flag for one of the governing equations.
@@ -124,6 +187,31 @@ public:
     */
     bool getLaplaceInitializationFlag(unsigned int index);
 
+    /**
+    * Method to get the type of nonlinear solver (the damped iteration or the Newton-Krylov solver) for one of the governing equations.
+    */
+    NonlinearSolverType getSolverType(unsigned int index);
+
+    /**
+    * Method to get the forcing term (the relative linear solver tolerance) of the first Newton-Krylov step for one of the governing equations.
+    */
+    double getInitialForcingTerm(unsigned int index);
+
+    /**
+    * Method to get the upper bound of the Eisenstat-Walker forcing term for one of the governing equations.
+    */
+    double getMaxForcingTerm(unsigned int index);
+
+    /**
+    * Method to get the coefficient of the Armijo sufficient decrease condition of the Newton-Krylov line search for one of the governing equations.
+    */
+    double getArmijoCoeff(unsigned int index);
+
+    /**
+    * Method to get the number of previous iterates mixed by Anderson acceleration for one of the governing equations (zero for no acceleration).
+    */
+    unsigned int getAndersonDepth(unsigned int index);
+
 private:
     unsigned int max_iterations;
 
@@ -132,6 +220,11 @@ private:
     std::vector<double> backtrack_residual_decrease_coeff_list;
     std::vector<double> default_damping_coefficient_list;
     std::vector<bool> laplace_for_initial_guess_list;
+    std::vector<NonlinearSolverType> solver_type_list;
+    std::vector<double> initial_forcing_term_list;
+    std::vector<double> max_forcing_term_list;
+    std::vector<double> armijo_coeff_list;
+    std::vector<unsigned int> anderson_depth_list;
 
 };
 
@@ -6,12 +6,18 @@
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <map>
 
 // dealii headers
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_local_storage.h>
+#include <deal.II/base/std_cxx11/shared_ptr.h>
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_cg.h>
 #include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_values.h>
@@ -38,6 +44,7 @@
 #include "variableValueContainer.h"
 #include "variableContainer.h"
 #include "SimplifiedGrainRepresentation.h"
+#include "LinearSolverPreconditioner.h"
 
 // define data types
 #ifndef scalarType
@@ -50,6 +57,10 @@ typedef dealii::parallel::distributed::Vector<double> vectorType;
 //macro for constants
 #define constV(a) make_vectorized_array(a)
 
+// The multigrid classes are only defined for deal.II version 9.0 and later (see LinearSolverMultigrid.h)
+template <int dim, int degree> class LinearSolverMultigrid;
+template <int dim, int degree> class LevelLHSOperator;
+
 //
 using namespace dealii;
 //
@@ -66,6 +77,9 @@ using namespace dealii;
 template <int dim, int degree>
 class MatrixFreePDE:public Subscriptor
 {
+  // The level operators of the multigrid preconditioner apply equationLHS through getLHSForSolution()
+  friend class LevelLHSOperator<dim,degree>;
+
  public:
   /**
    * Class contructor
@@ -180,8 +194,20 @@ class MatrixFreePDE:public Subscriptor
   std::vector<DoFHandler<dim>*>        dofHandlersSet_nonconst;
   /*Copies of locally_relevant_dofsSet elements, but stored as non-const.*/
   std::vector<IndexSet*>               locally_relevant_dofsSet_nonconst;
+  /*For each field, the index of the field that owns the FE object, DoF handler, locally relevant DoFs, and hanging node and periodicity
+   *constraints it uses. It is the field itself unless DoF handlers are shared, in which case the elements of the sets above are shared pointers.*/
+  std::vector<unsigned int>            sharedDoFFieldIndexSet;
+  /*Method to find an earlier field whose FE space and non-Dirichlet constraints a field can share (returns the field itself if there isn't one)*/
+  unsigned int getSharedDoFFieldIndex(unsigned int fieldIndex);
+  /*For each field, the index of its DoF handler in matrixFreeObject. Fields that share a DoF handler share one entry of the MatrixFree object,
+   *so its DoF indices only match the field indices if DoF handlers aren't shared. The multigrid level MatrixFree objects keep one entry per field.*/
+  std::vector<unsigned int>            dofIndexSet;
+  /*Method to get the DoF handlers and hanging node and periodicity constraints of the fields that own them, in the order of their DoF index*/
+  void getMatrixFreeDoFHandlers(std::vector<const DoFHandler<dim>*> &dof_handlers, std::vector<const ConstraintMatrix*> &constraints) const;
   /*Vector all the solution vectors in the problem. In a multi-field problem, each primal field has a solution vector associated with it.*/
   std::vector<vectorType*>             solutionSet;
+  /*Vector of the solution vectors at the start of the time step, only allocated for the implicit time-dependent fields (NULL otherwise).*/
+  std::vector<vectorType*>             oldSolutionSet;
   /*Vector all the residual (RHS) vectors in the problem. In a multi-field problem, each primal field has a residual vector associated with it.*/
   std::vector<vectorType*>             residualSet;
   /*Vector of parallel solution transfer objects. This is used only when adaptive meshing is enabled.*/
@@ -197,16 +223,53 @@ class MatrixFreePDE:public Subscriptor
    *Refer to deal.ii documentation of MatrixFree<dim> class for details.
    */
   MatrixFree<dim,double>               matrixFreeObject;
-  /*Vector to store the inverse of the mass matrix diagonal. Due to the choice of spectral elements with Guass-Lobatto quadrature, the mass matrix is diagonal.*/
-  vectorType                           invM;
+  /*Vectors to store the inverse of the mass matrix diagonal for the scalar and vector fields. Due to the choice of spectral elements with Guass-Lobatto quadrature, the mass matrix is diagonal.*/
+  vectorType                           invMscalar, invMvector;
   /*Vector to store the solution increment. This is a temporary vector used during implicit solves of the Elliptic fields.*/
   vectorType                           dU_vector, dU_scalar;
+  /*Preallocated scratch vectors with the layout of the scalar and of the vector non-explicit fields, so that no vectors are allocated during the time stepping*/
+  std::vector<vectorType>              scratchVectorsScalar, scratchVectorsVector;
+  /*Method to get one of the scratch vectors with the layout of a field*/
+  vectorType & getScratchVector(unsigned int fieldIndex, unsigned int index);
 
   //matrix free methods
   /*Current field index*/
   unsigned int currentFieldIndex;
+  /*Current substep of the subcycled explicit fields (0 for the first substep, where the RHS of all of the explicit fields is calculated)*/
+  unsigned int currentExplicitSubstep;
   /*Method to compute the inverse of the mass matrix*/
   void computeInvM();
+  /*Method to update the solution of the given explicit (or auxiliary) fields from their residuals in a single pass. With a fraction
+   *less than one, the explicit fields are only moved that fraction of the way to the updated solution (a substep of the time step).*/
+  void updateExplicitSolution(const std::vector<unsigned int> & fieldIndices, const double fraction=1.0);
+  /*Method to advance the subcycled explicit fields through their substeps (the RHS of the first substep is the RHS from computeExplicitRHS)*/
+  void updateSubcycledExplicitFields();
+  /*Method to store the solution of the implicit time-dependent fields at the start of the time step*/
+  void storeOldSolution();
+
+  // Methods and variables for the initial guesses of the linear solves
+  /*Vectors of the changes in the solution over the previous time steps (newest first) for the fields with an extrapolated initial guess,
+   *where the last vector holds the solution at the start of the current time step. For the fields that reuse the previous change in the
+   *solution, the single vector holds the change from the first linear solve of the last time step.*/
+  std::vector<std::vector<vectorType*> > solutionChangeHistorySet;
+  /*The time step of each stored change in the solution and the number of stored changes for each field*/
+  std::vector<std::vector<double> > solutionChangeDtHistorySet;
+  std::vector<unsigned int> solutionChangeHistorySize;
+  /*Method to set the initial guess for the first linear solve of a time step from the stored changes in the solution*/
+  void setLinearSolverInitialGuess(unsigned int fieldIndex, vectorType & dU);
+  /*Methods to store the solution at the start of the time step and the change in the solution at the end of it (for extrapolation)*/
+  void storeSolutionForChangeHistory();
+  void updateSolutionChangeHistory();
+
+  // Methods and variables for reusing the solution of time-independent fields between their solves
+  /*Copies of the fields each time-independent field depends on, from its last solve (only for the fields with a solve change threshold, empty otherwise)*/
+  std::vector<std::vector<vectorType*> > dependencySnapshotSet;
+  /*The increment of the last solve of each time-independent field (-1 means that it has to be solved, e.g. after the mesh changes)*/
+  std::vector<int> lastSolveIncrementSet;
+  /*Method to check whether a time-independent field can keep the solution from its last solve for this increment*/
+  bool reuseLastSolution(unsigned int fieldIndex);
+  /*Method to record the solve of a time-independent field and the current values of the fields it depends on*/
+  void storeLastSolve(unsigned int fieldIndex);
 
 
   /*AMR methods*/
@@ -216,9 +279,11 @@ class MatrixFreePDE:public Subscriptor
   /*Virtual method to define AMR refinement criterion. The default implementation uses the Kelly error estimate for estimative the error function. The user can supply a custom implementation to overload the default implementation.*/
   virtual void adaptiveRefineCriterion();
 
-  /*Method to compute the right hand side (RHS) residual vectors*/
+  /*Methods to compute the right hand side (RHS) residual vectors (of all of the explicit fields, or of a single nonexplicit field)*/
   void computeExplicitRHS();
-  void computeNonexplicitRHS();
+  void computeNonexplicitRHS(unsigned int fieldIndex);
+  /*Method to compute the RHS residual vectors of the explicit fields that take a substep after the first one*/
+  void computeSubcycledExplicitRHS(unsigned int substep);
 
   //virtual methods to be implemented in the derived class
   /*Method to calculate LHS(implicit solve)*/
@@ -226,6 +291,73 @@ class MatrixFreePDE:public Subscriptor
 		      vectorType &dst,
 		      const vectorType &src,
 		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  /*Method to calculate LHS for the given solution vectors (which may be on a multigrid level instead of the active mesh)*/
+  void getLHSForSolution(const MatrixFree<dim,double> &data,
+		      vectorType &dst,
+		      const vectorType &src,
+		      const std::vector<vectorType*> &solution_set,
+		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+
+  // Methods and variables for preconditioning the linear solves
+  /*Vectors of the inverse of the diagonal of the LHS for the fields solved with a Jacobi or Chebyshev preconditioner (NULL otherwise)*/
+  std::vector<vectorType*> invLHSDiagonalSet;
+  /*The same in single precision, used instead of invLHSDiagonalSet for the fields with a single precision preconditioner (NULL otherwise)*/
+  std::vector<parallel::distributed::Vector<float>*> invLHSDiagonalSingleSet;
+  /*Estimates of the largest eigenvalue of the Jacobi-preconditioned LHS for each field (only used with the Chebyshev preconditioner)*/
+  std::vector<double> LHSMaxEigenvalueSet;
+  /*The Jacobi or Chebyshev preconditioner of each field, kept between the solves (NULL otherwise). The second set is used instead for the fields with a single precision preconditioner.*/
+  std::vector<LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType>*> preconditionerSet;
+  std::vector<LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType,parallel::distributed::Vector<float> >*> preconditionerSingleSet;
+  /*The increment and time step at which the preconditioner for each field was last updated (an increment of -1 means it is out of date)*/
+  std::vector<int> preconditionerIncrementSet;
+  std::vector<double> preconditionerDtSet;
+
+  /*Method to compute the inverse of the diagonal of the LHS for a field, using the same cell machinery as getLHS*/
+  void computeInvLHSDiagonal(unsigned int fieldIndex);
+  void getLHSDiagonal(const MatrixFree<dim,double> &data,
+		      vectorType &dst,
+		      const vectorType &src,
+		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  void getLHSDiagonalForSolution(const MatrixFree<dim,double> &data,
+		      vectorType &dst,
+		      const std::vector<vectorType*> &solution_set,
+		      const std::pair<unsigned int,unsigned int> &cell_range) const;
+  /*Method to estimate the largest eigenvalue of the Jacobi-preconditioned LHS for a field with a few CG iterations*/
+  void estimateLHSMaxEigenvalue(unsigned int fieldIndex);
+  /*Method to recompute the preconditioner for a field if the mesh, the time step, or the coefficients of the LHS may have changed*/
+  void updatePreconditioner(unsigned int fieldIndex);
+  /*Method to solve for the change in the solution of a non-explicit field (into dU_scalar or dU_vector) with the chosen preconditioner and initial guess*/
+  void solveLinearSystem(unsigned int fieldIndex, SolverControl & solver_control, bool first_solve_of_time_step);
+
+  // Methods and variables for the Newton-Krylov nonlinear solver
+  /*The residual norm at the first nonlinear iteration of the solve, the residual norm at the last Newton step, and the forcing term of the last Newton step for each field*/
+  std::vector<double> newtonInitialResidualSet;
+  std::vector<double> newtonResidualSet;
+  std::vector<double> newtonForcingTermSet;
+  /*Method to compute the residual of a non-explicit field with the Dirichlet DOFs cleared and return its norm*/
+  double computeNonexplicitResidualNorm(unsigned int fieldIndex);
+  /*Method to take one Newton step with an Eisenstat-Walker linear tolerance and an Armijo line search, returning true if the field has converged*/
+  bool solveNewtonKrylovStep(unsigned int fieldIndex, unsigned int nonlinear_it_index, bool first_solve_of_time_step);
+
+  // Methods and variables for the Anderson acceleration of the fixed-point iterations of nonlinear auxiliary fields
+  /*Preallocated history for each field with Anderson acceleration (empty otherwise): the differences between successive fixed-point
+   *residuals, then the differences between successive fixed-point iterates (one ring of depth vectors each), then the last residual and iterate*/
+  std::vector<std::vector<vectorType*> > andersonHistorySet;
+  /*The number of fixed-point iterates of each field in the current solve (which determines the number of stored differences and the next slot of the rings)*/
+  std::vector<unsigned int> andersonIterateCount;
+  /*Method to replace the latest fixed-point iterate of a field (with the old iterate minus the new one in dU) by the Anderson mixture of the stored iterates*/
+  void applyAndersonAcceleration(unsigned int fieldIndex);
+
+  /*The geometric multigrid hierarchies for the fields solved with the multigrid preconditioner (NULL otherwise, and after each change of the mesh)*/
+  std::vector<LinearSolverMultigrid<dim,degree>*> multigridSet;
+  /*Method to set up the level DOFs, constraints, MatrixFree objects, transfer and LHS operators of the multigrid hierarchy for a field*/
+  void setupMultigrid(unsigned int fieldIndex);
+  /*Method to transfer the solution to the multigrid levels and recompute the level smoothers for a field*/
+  void updateMultigrid(unsigned int fieldIndex);
+  /*Method to solve the linear system for a field with CG preconditioned by a multigrid V-cycle*/
+  void solveLinearSystemMultigrid(unsigned int fieldIndex, SolverCG<vectorType> & solver, vectorType & dU);
+  /*Method to delete all of the multigrid hierarchies*/
+  void clearMultigrid();
 
 
   bool generatingInitialGuess;
@@ -249,9 +381,16 @@ class MatrixFreePDE:public Subscriptor
 		       const std::vector<vectorType*> &src,
 		       const std::pair<unsigned int,unsigned int> &cell_range) const;
 
-  void getNonexplicitRHS (const MatrixFree<dim,double> &data,
+  /*Method to add a multiple of the mass matrix times each explicit field on a cell batch to its residual (used with local time stepping)*/
+  void addExplicitMassTerms (const MatrixFree<dim,double> &data,
             std::vector<vectorType*> &dst,
             const std::vector<vectorType*> &src,
+            const unsigned int cell,
+            const double scale) const;
+
+  void getNonexplicitRHS (const MatrixFree<dim,double> &data,
+            vectorType &dst,
+            const std::vector<vectorType*> &src,
             const std::pair<unsigned int,unsigned int> &cell_range) const;
 
   virtual void explicitEquationRHS(variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
@@ -266,23 +405,67 @@ class MatrixFreePDE:public Subscriptor
   virtual void postProcessedFields(const variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list,
                                                               variableContainer<dim,degree,dealii::VectorizedArray<double> > & pp_variable_list,
                                                               const dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc) const {};
-  void computePostProcessedFields(std::vector<vectorType*> &postProcessedSet);
+  /*The post-processed fields, for the output, the integrals, and any other analysis of them. They are allocated in the first call to computePostProcessedFields() and resized in reinit().*/
+  std::vector<vectorType*> postProcessedSet;
+  /*Method to compute the post-processed fields into postProcessedSet*/
+  void computePostProcessedFields();
 
   void getPostProcessedFields(const dealii::MatrixFree<dim,double> &data,
                                                                                       std::vector<vectorType*> &dst,
                                                                                       const std::vector<vectorType*> &src,
                                                                                       const std::pair<unsigned int,unsigned int> &cell_range);
 
+  /*Variable containers for the cell loops, kept for each thread so that their FEEvaluation objects aren't rebuilt for every cell range. They are keyed by
+   *the MatrixFree object (the multigrid levels have their own) and the list of variables, and are cleared whenever one of the MatrixFree objects is reinitialized or deleted.*/
+  typedef std::map<std::pair<const MatrixFree<dim,double>*,const std::vector<variable_info>*>,
+                   std_cxx11::shared_ptr<variableContainer<dim,degree,dealii::VectorizedArray<double> > > > variableContainerCacheType;
+  mutable Threads::ThreadLocalStorage<variableContainerCacheType> variableContainerCache;
+  /*Method to get the variable container for a MatrixFree object and list of variables for the current thread, building it on first use. The change in
+   *solution list is only given for the LHS and the fixed index is only used for the post-processed fields.*/
+  variableContainer<dim,degree,dealii::VectorizedArray<double> > & getVariableContainer(const MatrixFree<dim,double> &data,
+                                                                                       const std::vector<variable_info> &varInfoList,
+                                                                                       const std::vector<variable_info> * varChangeInfoList=NULL,
+                                                                                       bool fixed_index=false) const;
+  /*Method to delete the cached variable containers, which must be called before any MatrixFree object they refer to is reinitialized or deleted*/
+  void clearVariableContainerCache();
+
   //methods to apply dirichlet BC's
-  /*Map of degrees of freedom to the corresponding Dirichlet boundary conditions, if any.*/
-  std::vector<std::map<dealii::types::global_dof_index, double>*> valuesDirichletSet;
+  /*Local indices (in the locally owned part of the vectors) of the locally owned Dirichlet DOFs of each field, in increasing order*/
+  std::vector<std::vector<unsigned int> > localDirichletDoFSet;
+  /*Method to set the entries of a vector at the Dirichlet DOFs of a field to zero*/
+  void zeroDirichletDoFs(vectorType & vec, unsigned int fieldIndex) const;
+  /*Method to copy the entries of a vector at the Dirichlet DOFs of a field into another vector*/
+  void copyDirichletDoFs(vectorType & dst, const vectorType & src, unsigned int fieldIndex) const;
   /*Virtual method to mark the boundaries for applying Dirichlet boundary conditions.  This is usually expected to be provided by the user.*/
   void markBoundaries(parallel::distributed::Triangulation<dim> &) const;
   /** Method for applying Dirichlet boundary conditions.*/
   void applyDirichletBCs();
 
-  /** Method for applying Neumann boundary conditions.*/
-  void applyNeumannBCs();
+  /*Cache of the non-uniform Dirichlet DOFs of each field (the DOF, its support point, and the direction and component of its BC), so that
+   *time-dependent BCs only have their values re-evaluated each time step instead of the constraints being rebuilt*/
+  struct nonUniformDirichletDoF {
+      types::global_dof_index dof_index;
+      Point<dim> support_point;
+      unsigned int direction;
+      unsigned int component;
+  };
+  std::vector<std::vector<nonUniformDirichletDoF> > nonUniformDirichletDoFSet;
+  /*Method to check whether a field has a non-uniform Dirichlet BC*/
+  bool hasNonUniformDirichletBCs(unsigned int fieldIndex) const;
+  /*Method to find the non-uniform Dirichlet DOFs of a field, called after its Dirichlet constraints are set up*/
+  void setNonUniformDirichletDoFs(unsigned int fieldIndex);
+  /*Method to re-evaluate the non-uniform Dirichlet BCs at the current time and update the inhomogeneities of the constraints*/
+  void updateNonUniformDirichletBCs();
+
+  /*The Neumann BC terms of each field (the boundary integral of each shape function times the Neumann value) from the cells in each local
+   *time stepping group, at the locally owned DOFs where they are nonzero, as local indices and values. The Neumann values are constant,
+   *so they are assembled once per mesh.*/
+  std::vector<std::vector<std::vector<unsigned int> > > localNeumannDoFSet;
+  std::vector<std::vector<std::vector<double> > > neumannTermSet;
+  /*Method to assemble the Neumann BC terms for a field on the current mesh*/
+  void setNeumannBCs(unsigned int fieldIndex);
+  /** Method for applying Neumann boundary conditions, adding their terms to the residual of a field.*/
+  void applyNeumannBCs(unsigned int fieldIndex);
 
   // Methods to apply periodic BCs
   void setPeriodicity();
@@ -360,12 +543,54 @@ class MatrixFreePDE:public Subscriptor
   bool first_integrated_var_output_complete;
 
   // Methods and variables for integration
-  double integrated_var;
-  unsigned int integral_index;
+  std::vector<double> integrated_vars;
+  /*The DoF index in matrixFreeObject of each field being integrated*/
+  std::vector<unsigned int> integral_dof_handler_indices;
   dealii::Threads::Mutex assembler_lock;
 
   void computeIntegralMF(double& integratedField, int index, const std::vector<vectorType*> postProcessedSet);
 
+  void computeIntegralsMF(std::vector<double>& integratedFields, const std::vector<unsigned int>& dof_handler_indices, const std::vector<vectorType*> variableSet);
+
+  // Methods and variables for adaptive time stepping
+  /*Vectors to store the rate of change of each explicit field over the last time step (only allocated with adaptive time stepping)*/
+  std::vector<vectorType*> explicitRateSet;
+  /*Vectors to store the solution of each explicit field at the start of the time step, so that a rejected time step can be redone (only allocated with adaptive time stepping)*/
+  std::vector<vectorType*> explicitStepStartSet;
+  bool explicit_rates_set;
+  double max_rate_change;
+  double nominal_dtValue, previous_dtValue;
+  /*The stability limit on the time step for the current mesh, and the smallest cell diameter that the declared stable time step is for*/
+  double stable_dtValue, stable_dt_min_cell_diameter;
+
+  /*Method to set the time step for the next increment so that it lands on the next output, checkpoint, or the final time*/
+  void setTimeStepForNextIncrement();
+  /*Method to estimate the local time discretization error of the explicit fields in the last time step*/
+  double adaptiveTimeStepErrorEstimate() const;
+  /*Method to check the error estimate of the time step just taken and, if it is over the tolerance, reset the fields to the start of the time step with a shorter time step*/
+  bool rejectAdaptiveTimeStep();
+  /*Method to pick the time step for the next increment from the error estimate of the last one*/
+  void updateAdaptiveTimeStep();
+  /*Method to scale the stable time step to the smallest cell of the current mesh*/
+  void updateStableTimeStep();
+  /*Method to check whether an output/checkpoint is due (by increment, or by time with adaptive time stepping)*/
+  bool scheduledEventDue(const std::vector<unsigned int> & increment_list, const std::vector<double> & time_list, unsigned int list_index) const;
+  /*Method to check whether the end of the simulation has been reached*/
+  bool timeSteppingComplete() const;
+
+  // Methods and variables for local time stepping of the explicit fields
+  /*The local time stepping group of each cell batch of the matrixFreeObject (set from the finest cell in the batch)*/
+  std::vector<unsigned int> cellBatchTimeStepGroup;
+  /*The multiple of the time step that each group is advanced by in the current increment (zero if it isn't stepped)*/
+  std::vector<double> timeStepGroupFactor;
+
+  /*Method to sort the cell batches into the local time stepping groups by refinement level*/
+  void setLocalTimeStepGroups();
+  /*Method to set which groups are stepped in the current increment and by how much*/
+  void updateTimeStepGroupFactors();
+  /*Method to set the refinement level of each active cell as its vectorization category, so that each cell batch has cells of one level*/
+  void setCellVectorizationCategories(typename MatrixFree<dim,double>::AdditionalData & additional_data) const;
+
   void getIntegralMF (const MatrixFree<dim,double> &data,
 		       std::vector<vectorType*> &dst,
 		       const std::vector<vectorType*> &src,
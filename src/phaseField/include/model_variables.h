@@ -44,6 +44,8 @@ struct variable_info
     bool value_residual;
     bool gradient_residual;
     bool var_needed;
+    bool need_old_value;
+    unsigned int old_scalar_or_vector_index;
 };
 
 #endif /* INCLUDE_MODELVARIABLE_H_ */
@@ -1,4 +1,4 @@
-// At some point, rewrite the following four methods as a single templated method
+// At some point, rewrite the following five methods as a single templated method
 #ifndef INCLUDE_SORTINDEXENTRYPAIRLIST_H_
 #define INCLUDE_SORTINDEXENTRYPAIRLIST_H_
 
@@ -10,5 +10,6 @@ std::vector<bool> sortIndexEntryPairList(const std::vector<std::pair<unsigned in
 std::vector<std::string> sortIndexEntryPairList(const std::vector<std::pair<unsigned int,std::string> > unsorted_pair_list, unsigned int number_of_variables, std::string default_value);
 std::vector<fieldType> sortIndexEntryPairList(const std::vector<std::pair<unsigned int,fieldType> > unsorted_pair_list, unsigned int number_of_variables, fieldType default_value);
 std::vector<PDEType> sortIndexEntryPairList(const std::vector<std::pair<unsigned int,PDEType> > unsorted_pair_list, unsigned int number_of_variables, PDEType default_value);
+std::vector<unsigned int> sortIndexEntryPairList(const std::vector<std::pair<unsigned int,unsigned int> > unsorted_pair_list, unsigned int number_of_variables, unsigned int default_value);
 
 #endif
@@ -88,9 +88,28 @@ public:
 	double finalTime;
 	unsigned int totalIncrements;
 
+	// Adaptive time step parameters (with adaptive time stepping, outputs and checkpoints are scheduled by time)
+	bool adaptive_time_stepping;
+	double adaptive_time_step_tolerance;
+	double max_dtValue, min_dtValue, stable_dtValue;
+	std::vector<double> outputTimeList;
+	std::vector<double> checkpointTimeList;
+
+	// Local time stepping parameters (the number of groups of refinement levels with their own time steps)
+	unsigned int local_time_step_groups;
+
+	// Parallelization parameters (the maximum number of threads per MPI process)
+	unsigned int number_of_threads;
+
+	// Flag for whether fields with the same FE space and hanging node/periodicity constraints share their DoF handler
+	bool share_dof_handlers;
+
 	// Elliptic solver parameters
     LinearSolverParameters linear_solver_parameters;
 
+    // Flag for whether any linear solve uses the multigrid preconditioner (the mesh then keeps its level hierarchy)
+    bool use_multigrid;
+
     // Nonlinear solver parameters
     NonlinearSolverParameters nonlinear_solver_parameters;
 
@@ -103,10 +122,25 @@ public:
 
     std::vector<bool> var_nonlinear;
 
+    // The indices of the other variables whose values, gradients, or hessians are needed by each non-explicit equation
+    std::vector<std::vector<unsigned int> > var_dependencies_nonexplicit;
+
 	// Variables needed to calculate the RHS
     unsigned int num_var_explicit_RHS, num_var_nonexplicit_RHS;
 	std::vector<variable_info> varInfoListExplicitRHS, varInfoListNonexplicitRHS;
 
+    // Variables needed for the mass terms of the explicit equations with local time stepping (the value of each explicit field and its value residual)
+    std::vector<variable_info> varInfoListExplicitMass;
+
+    // The number of substeps each explicit field takes per time step (1, or the same number for all of the subcycled fields), and the
+    // variables needed to calculate the RHS in each substep after the first one (only the residuals of the subcycled fields are calculated)
+    std::vector<unsigned int> var_explicit_subcycling_steps;
+    unsigned int max_explicit_subcycling_steps;
+    std::vector<std::vector<variable_info> > varInfoListExplicitRHSSubcycle;
+
+    // Variables needed to calculate the RHS of each nonexplicit equation on its own (empty for the explicit equations)
+    std::vector<std::vector<variable_info> > varInfoListNonexplicitRHSByField;
+
 	// Variables needed to calculate the LHS
 	unsigned int num_var_LHS;
 	std::vector<variable_info> varInfoListLHS;
@@ -139,6 +173,9 @@ public:
 	// List of boundary conditions
 	std::vector<varBCs<dim> > BC_list;
 
+	// Flag for whether the non-uniform Dirichlet BCs are updated every time step
+	bool time_dependent_nonuniform_BCs;
+
 	// List of user-defined constants
 	std::vector<boost::variant<double, int, bool,dealii::Tensor<1,dim>, dealii::Tensor<2,dim>, dealii::Tensor<2,2*dim-1+dim/3> > > model_constants;
 
@@ -29,6 +29,8 @@ public:
 
     void set_output_integral(unsigned int index, bool);
 
+    void set_explicit_subcycling_steps(unsigned int index, unsigned int);
+
     // Variable inputs (v2.0)
     std::vector<std::pair<unsigned int, std::string> > var_name_list;
     std::vector<std::pair<unsigned int, fieldType> > var_type_list;
@@ -53,6 +55,7 @@ public:
     std::vector<std::pair<unsigned int, bool> > need_hessian_list_PP;
     std::vector<std::pair<unsigned int, bool> > need_value_list_nucleation;
     std::vector<std::pair<unsigned int, bool> > nucleating_variable_list;
+    std::vector<std::pair<unsigned int, unsigned int> > explicit_subcycling_steps_list;
 
     std::vector<std::pair<unsigned int, std::string> > var_name_list_PP;
     std::vector<std::pair<unsigned int, fieldType> > var_type_list_PP;
@@ -88,6 +91,9 @@ public:
     std::vector<bool> nucleating_variable;
     std::vector<bool> need_value_nucleation;
 
+    // The number of substeps each explicit field takes per time step
+    std::vector<unsigned int> var_explicit_subcycling_steps;
+
     unsigned int pp_number_of_variables;
 
 	std::vector<std::string> pp_var_name;
@@ -38,8 +38,11 @@ public:
     // Constructors
 
     // Standard contructor, used for most situations
-    variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList, std::vector<variable_info> _varChangeInfoList);
-    variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList);
+    // The DoF index in "data" of each variable can be given, for when variables share a DoF handler (by default it is the variable index)
+    variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList, std::vector<variable_info> _varChangeInfoList,
+                      const std::vector<unsigned int> &_dof_indices=std::vector<unsigned int>());
+    variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList,
+                      const std::vector<unsigned int> &_dof_indices=std::vector<unsigned int>());
     // Nonstandard constructor, used when only one index of "data" should be used, use with care!
     variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList, unsigned int fixed_index);
 
@@ -51,6 +54,10 @@ public:
     dealii::Tensor<2, dim, T > get_vector_gradient(unsigned int global_variable_index) const;
     dealii::Tensor<3, dim, T > get_vector_hessian(unsigned int global_variable_index) const;
 
+    // Methods to get the value of an implicit time-dependent variable at the start of the time step
+    T get_old_scalar_value(unsigned int global_variable_index) const;
+    dealii::Tensor<1, dim, T > get_old_vector_value(unsigned int global_variable_index) const;
+
     T get_change_in_scalar_value(unsigned int global_variable_index) const;
     dealii::Tensor<1, dim, T > get_change_in_scalar_gradient(unsigned int global_variable_index) const;
     dealii::Tensor<2, dim, T > get_change_in_scalar_hessian(unsigned int global_variable_index) const;
@@ -59,6 +66,7 @@ public:
     dealii::Tensor<3, dim, T > get_change_in_vector_hessian(unsigned int global_variable_index) const;
 
     // Methods to set the value residual and the gradient residual (this is how the user sets these values in equations.h)
+    // Terms for residuals that aren't being calculated (e.g. those of the other nonexplicit equations) are ignored
     void set_scalar_value_term_RHS(unsigned int global_variable_index, T val);
     void set_scalar_gradient_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > grad);
     void set_vector_value_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > val);
@@ -72,14 +80,23 @@ public:
 
     // Initialize, read DOFs, and set evaulation flags for each variable
     void reinit_and_eval(const std::vector<vectorType*> &src, unsigned int cell);
+    void reinit_and_eval_old_solution(const std::vector<vectorType*> &old_src, unsigned int cell);
     void reinit_and_eval_change_in_solution(const vectorType &src, unsigned int cell, unsigned int var_being_solved);
     void reinit_and_eval_LHS(const vectorType &src, const std::vector<vectorType*> solutionSet, unsigned int cell, unsigned int var_being_solved);
 
     // Only initialize the FEEvaluation object for each variable (used for post-processing)
     void reinit(unsigned int cell);
 
-    // Integrate the residuals and distribute from local to global
-    void integrate_and_distribute(std::vector<vectorType*> &dst);
+    // Methods to build the diagonal of the LHS one local DOF at a time (used for preconditioning)
+    unsigned int get_num_change_in_solution_dofs(const unsigned int var_being_solved) const;
+    void reinit_change_in_solution(unsigned int cell, const unsigned int var_being_solved);
+    void eval_change_in_solution_unit_vector(const unsigned int dof_index, const unsigned int var_being_solved);
+    T integrate_change_in_solution_LHS_entry(const unsigned int dof_index, const unsigned int var_being_solved);
+    void distribute_change_in_solution_local_vector(const dealii::AlignedVector<T> &local_vector, vectorType &dst, const unsigned int var_being_solved);
+
+    // Integrate the residuals and distribute from local to global (the residuals of all of the variables can be scaled by a factor)
+    void integrate_and_distribute(std::vector<vectorType*> &dst, const double residual_scale=1.0);
+    void integrate_and_distribute(vectorType &dst, const unsigned int var_index);
     void integrate_and_distribute_change_in_solution_LHS(vectorType &dst, const unsigned int var_being_solved);
 
     // The quadrature point index, a method to get the number of quadrature points per cell, and a method to get the xyz coordinates for the quadrature point
@@ -94,17 +111,306 @@ private:
     // The number of variables
     unsigned int num_var;
 
+    // The DoF index in the MatrixFree object of each variable
+    std::vector<unsigned int> var_dof_index;
+
+    // Method to set the DoF index of each variable (the variable index if none are given)
+    void set_dof_indices(const std::vector<unsigned int> &dof_indices);
+
     // Vectors of the actual FEEvaluation objects for each active variable, split into scalar variables and vector variables for type reasons
     std::vector<dealii::FEEvaluation<dim,degree,degree+1,1,double> > scalar_vars;
     std::vector<dealii::FEEvaluation<dim,degree,degree+1,dim,double> > vector_vars;
 
+    // Consecutive scalar variables with the same DoF handler and the same flags are evaluated together, scalar_block_size at a time,
+    // as the components of one FEEvaluation object (which reads each component from the vector of its variable)
+    static const unsigned int scalar_block_size = 4;
+    std::vector<dealii::FEEvaluation<dim,degree,degree+1,scalar_block_size,double> > scalar_block_vars;
+
+    // The block of each variable (-1 if it isn't in a block), its component in the block, and the first variable of each block
+    std::vector<int> var_block_index;
+    std::vector<unsigned int> var_block_component;
+    std::vector<unsigned int> block_first_var;
+
+    // The residual terms set for each block at the current quadrature point (all components are submitted together)
+    std::vector<dealii::Tensor<1,scalar_block_size,T> > block_value_residuals;
+    std::vector<dealii::Tensor<1,scalar_block_size,dealii::Tensor<1,dim,T> > > block_gradient_residuals;
+
+    // Method to group the scalar variables that can be evaluated together into blocks
+    void set_up_scalar_blocks(const dealii::MatrixFree<dim,double> &data);
+
+    // The steps to read and evaluate the variables and to integrate and distribute their residuals, resolved from the
+    // variable attributes when the container is constructed so that the loops over the cells don't branch on them
+    struct evaluation_step {
+        unsigned int var_index;
+        unsigned int fe_eval_index;
+        bool evaluate;
+        bool need_value, need_gradient, need_hessian;
+        bool integrate;
+        bool value_residual, gradient_residual;
+    };
+    std::vector<evaluation_step> scalar_steps, vector_steps, scalar_block_steps;
+
+    // Method to set up the evaluation steps of the needed variables (after the blocks are set up)
+    void set_up_evaluation_steps();
+
+    // Method to scale the integrated residual (the local DOF values) of an FEEvaluation object
+    template <typename FEEvaluationType>
+    void scale_dof_values(FEEvaluationType &fe_eval, const double scale) const;
+
     std::vector<dealii::FEEvaluation<dim,degree,degree+1,1,double> > scalar_change_in_vars;
     std::vector<dealii::FEEvaluation<dim,degree,degree+1,dim,double> > vector_change_in_vars;
 
+    std::vector<dealii::FEEvaluation<dim,degree,degree+1,1,double> > scalar_old_vars;
+    std::vector<dealii::FEEvaluation<dim,degree,degree+1,dim,double> > vector_old_vars;
+
     // Object containing some information about each variable (indices, whether the val/grad/hess is needed, etc)
     std::vector<variable_info> varInfoList;
     std::vector<variable_info> varChangeInfoList;
 
 };
 
+// The methods to get the values and to set the residual terms are called at every quadrature point from the user's equations,
+// so they are defined in the header where they can be inlined into the equations. The variable layout is set at run time
+// from the variable attributes, so they still check the flags of the variable (and whether it is in a block) at each call.
+
+// Need to add index checking to these functions so that an error is thrown if the index wasn't set
+template <int dim, int degree, typename T>
+T variableContainer<dim,degree,T>::get_scalar_value(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_value){
+        if (var_block_index[global_variable_index] >= 0){
+            return scalar_block_vars[var_block_index[global_variable_index]].get_value(q_point)[var_block_component[global_variable_index]];
+        }
+        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_scalar_gradient(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_gradient){
+        if (var_block_index[global_variable_index] >= 0){
+            return scalar_block_vars[var_block_index[global_variable_index]].get_gradient(q_point)[var_block_component[global_variable_index]];
+        }
+        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_scalar_hessian(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_hessian){
+        if (var_block_index[global_variable_index] >= 0){
+            return scalar_block_vars[var_block_index[global_variable_index]].get_hessian(q_point)[var_block_component[global_variable_index]];
+        }
+        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_vector_value(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_value){
+        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_vector_gradient(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_gradient){
+        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<3, dim, T > variableContainer<dim,degree,T>::get_vector_hessian(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_hessian){
+        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+T variableContainer<dim,degree,T>::get_old_scalar_value(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_old_value){
+        return scalar_old_vars[varInfoList[global_variable_index].old_scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of an old variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_old_vector_value(unsigned int global_variable_index) const
+{
+    if (varInfoList[global_variable_index].need_old_value){
+        return vector_old_vars[varInfoList[global_variable_index].old_scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of an old variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+// Need to add index checking to these functions so that an error is thrown if the index wasn't set
+template <int dim, int degree, typename T>
+T variableContainer<dim,degree,T>::get_change_in_scalar_value(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_value){
+        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_change_in_scalar_gradient(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_gradient){
+        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_change_in_scalar_hessian(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_hessian){
+        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_value(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_value){
+        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_gradient(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_gradient){
+        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+template <int dim, int degree, typename T>
+dealii::Tensor<3, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_hessian(unsigned int global_variable_index) const
+{
+    if (varChangeInfoList[global_variable_index].need_hessian){
+        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
+        abort();
+    }
+}
+
+// The methods to set the residual terms
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_scalar_value_term_RHS(unsigned int global_variable_index, T val){
+    if (varInfoList[global_variable_index].value_residual){
+        if (var_block_index[global_variable_index] >= 0){
+            unsigned int block = var_block_index[global_variable_index];
+            block_value_residuals[block][var_block_component[global_variable_index]] = val;
+            scalar_block_vars[block].submit_value(block_value_residuals[block],q_point);
+        }
+        else {
+            scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
+        }
+    }
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_scalar_gradient_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > grad){
+    if (varInfoList[global_variable_index].gradient_residual){
+        if (var_block_index[global_variable_index] >= 0){
+            unsigned int block = var_block_index[global_variable_index];
+            block_gradient_residuals[block][var_block_component[global_variable_index]] = grad;
+            scalar_block_vars[block].submit_gradient(block_gradient_residuals[block],q_point);
+        }
+        else {
+            scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
+        }
+    }
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_vector_value_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > val){
+    if (varInfoList[global_variable_index].value_residual){
+        vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
+    }
+}
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_vector_gradient_term_RHS(unsigned int global_variable_index, dealii::Tensor<2, dim, T > grad){
+    if (varInfoList[global_variable_index].gradient_residual){
+        vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
+    }
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_scalar_value_term_LHS(unsigned int global_variable_index, T val){
+    scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_scalar_gradient_term_LHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > grad){
+    scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_vector_value_term_LHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > val){
+    vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
+}
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_vector_gradient_term_LHS(unsigned int global_variable_index, dealii::Tensor<2, dim, T > grad){
+    vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
+}
+
 #endif
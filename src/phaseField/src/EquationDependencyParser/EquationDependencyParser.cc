@@ -19,6 +19,7 @@ void EquationDependencyParser::parse(
         need_value_nonexplicit_RHS.push_back(false);
         need_gradient_nonexplicit_RHS.push_back(false);
         need_hessian_nonexplicit_RHS.push_back(false);
+        need_value_old_nonexplicit_RHS.push_back(false);
         need_value_nonexplicit_LHS.push_back(false);
         need_gradient_nonexplicit_LHS.push_back(false);
         need_hessian_nonexplicit_LHS.push_back(false);
@@ -27,6 +28,19 @@ void EquationDependencyParser::parse(
         need_hessian_change_nonexplicit_LHS.push_back(false);
     }
 
+    // The flags for each non-explicit equation are set first and then combined into the flags above
+    std::vector<bool> no_var_needed(var_name.size(),false);
+    eq_need_value_nonexplicit_RHS.assign(var_name.size(),no_var_needed);
+    eq_need_gradient_nonexplicit_RHS.assign(var_name.size(),no_var_needed);
+    eq_need_hessian_nonexplicit_RHS.assign(var_name.size(),no_var_needed);
+    eq_need_value_old_nonexplicit_RHS.assign(var_name.size(),no_var_needed);
+    eq_need_value_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+    eq_need_gradient_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+    eq_need_hessian_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+    eq_need_value_change_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+    eq_need_gradient_change_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+    eq_need_hessian_change_nonexplicit_LHS.assign(var_name.size(),no_var_needed);
+
     // Now parse the dependency strings to set the flags to true where needed
     for (unsigned int i=0; i<var_name.size(); i++){
 
@@ -42,7 +56,7 @@ void EquationDependencyParser::parse(
 
             bool need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear;
 
-            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), need_value_explicit_RHS, need_gradient_explicit_RHS, need_hessian_explicit_RHS, need_value_residual_entry, need_gradient_residual_entry,single_var_nonlinear);
+            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), need_value_explicit_RHS, need_gradient_explicit_RHS, need_hessian_explicit_RHS, need_value_old_nonexplicit_RHS, need_value_residual_entry, need_gradient_residual_entry,single_var_nonlinear);
 
             //std::cout << "RHS Nonlinear flag for var " << i << " :" << single_var_nonlinear << std::endl;
 
@@ -60,7 +74,7 @@ void EquationDependencyParser::parse(
         else if (var_eq_type[i] == AUXILIARY){
             bool need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear;
 
-            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), need_value_nonexplicit_RHS, need_gradient_nonexplicit_RHS, need_hessian_nonexplicit_RHS, need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear);
+            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), eq_need_value_nonexplicit_RHS[i], eq_need_gradient_nonexplicit_RHS[i], eq_need_hessian_nonexplicit_RHS[i], eq_need_value_old_nonexplicit_RHS[i], need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear);
 
             var_nonlinear.push_back(single_var_nonlinear);
 
@@ -78,14 +92,14 @@ void EquationDependencyParser::parse(
 
             bool need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear_RHS, single_var_nonlinear_LHS;
 
-            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), need_value_nonexplicit_RHS, need_gradient_nonexplicit_RHS, need_hessian_nonexplicit_RHS, need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear_RHS);
+            parseDependencyListRHS(var_name, var_eq_type, i, sorted_dependencies_value_RHS.at(i), sorted_dependencies_gradient_RHS.at(i), eq_need_value_nonexplicit_RHS[i], eq_need_gradient_nonexplicit_RHS[i], eq_need_hessian_nonexplicit_RHS[i], eq_need_value_old_nonexplicit_RHS[i], need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear_RHS);
 
             //std::cout << "RHS Nonlinear flag for var " << i << " :" << single_var_nonlinear_RHS << std::endl;
 
             need_value_residual_nonexplicit_RHS.push_back(need_value_residual_entry);
             need_gradient_residual_nonexplicit_RHS.push_back(need_gradient_residual_entry);
 
-            parseDependencyListLHS(var_name, var_eq_type, i, sorted_dependencies_value_LHS.at(i), sorted_dependencies_gradient_LHS.at(i), need_value_nonexplicit_LHS, need_gradient_nonexplicit_LHS, need_hessian_nonexplicit_LHS, need_value_change_nonexplicit_LHS, need_gradient_change_nonexplicit_LHS, need_hessian_change_nonexplicit_LHS, need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear_LHS);
+            parseDependencyListLHS(var_name, var_eq_type, i, sorted_dependencies_value_LHS.at(i), sorted_dependencies_gradient_LHS.at(i), eq_need_value_nonexplicit_LHS[i], eq_need_gradient_nonexplicit_LHS[i], eq_need_hessian_nonexplicit_LHS[i], eq_need_value_change_nonexplicit_LHS[i], eq_need_gradient_change_nonexplicit_LHS[i], eq_need_hessian_change_nonexplicit_LHS[i], need_value_residual_entry, need_gradient_residual_entry, single_var_nonlinear_LHS);
 
             //std::cout << "LHS Nonlinear flag for var " << i << " :" << single_var_nonlinear_LHS << std::endl;
 
@@ -99,10 +113,26 @@ void EquationDependencyParser::parse(
 
         }
     }
+
+    // Combine the flags for the non-explicit equations
+    for (unsigned int i=0; i<var_name.size(); i++){
+        for (unsigned int var=0; var<var_name.size(); var++){
+            need_value_nonexplicit_RHS.at(var) = need_value_nonexplicit_RHS.at(var) || eq_need_value_nonexplicit_RHS[i][var];
+            need_gradient_nonexplicit_RHS.at(var) = need_gradient_nonexplicit_RHS.at(var) || eq_need_gradient_nonexplicit_RHS[i][var];
+            need_hessian_nonexplicit_RHS.at(var) = need_hessian_nonexplicit_RHS.at(var) || eq_need_hessian_nonexplicit_RHS[i][var];
+            need_value_old_nonexplicit_RHS.at(var) = need_value_old_nonexplicit_RHS.at(var) || eq_need_value_old_nonexplicit_RHS[i][var];
+            need_value_nonexplicit_LHS.at(var) = need_value_nonexplicit_LHS.at(var) || eq_need_value_nonexplicit_LHS[i][var];
+            need_gradient_nonexplicit_LHS.at(var) = need_gradient_nonexplicit_LHS.at(var) || eq_need_gradient_nonexplicit_LHS[i][var];
+            need_hessian_nonexplicit_LHS.at(var) = need_hessian_nonexplicit_LHS.at(var) || eq_need_hessian_nonexplicit_LHS[i][var];
+            need_value_change_nonexplicit_LHS.at(var) = need_value_change_nonexplicit_LHS.at(var) || eq_need_value_change_nonexplicit_LHS[i][var];
+            need_gradient_change_nonexplicit_LHS.at(var) = need_gradient_change_nonexplicit_LHS.at(var) || eq_need_gradient_change_nonexplicit_LHS[i][var];
+            need_hessian_change_nonexplicit_LHS.at(var) = need_hessian_change_nonexplicit_LHS.at(var) || eq_need_hessian_change_nonexplicit_LHS[i][var];
+        }
+    }
 }
 
 
-void EquationDependencyParser::parseDependencyListRHS(std::vector<std::string> var_name, std::vector<PDEType> var_eq_type, unsigned int var_index, std::string value_dependencies, std::string gradient_dependencies, std::vector<bool> & need_value, std::vector<bool> & need_gradient, std::vector<bool> & need_hessian, bool & need_value_residual, bool & need_gradient_residual, bool & is_nonlinear){
+void EquationDependencyParser::parseDependencyListRHS(std::vector<std::string> var_name, std::vector<PDEType> var_eq_type, unsigned int var_index, std::string value_dependencies, std::string gradient_dependencies, std::vector<bool> & need_value, std::vector<bool> & need_gradient, std::vector<bool> & need_hessian, std::vector<bool> & need_value_old, bool & need_value_residual, bool & need_gradient_residual, bool & is_nonlinear){
 
     // Split the dependency strings into lists of entries
     std::vector<std::string> split_value_dependency_list = dealii::Utilities::split_string_list(value_dependencies);
@@ -142,6 +172,10 @@ void EquationDependencyParser::parseDependencyListRHS(std::vector<std::string> v
             std::string hess_var_name = {"hess()"};
             hess_var_name.insert(--hess_var_name.end(),var_name.at(var).begin(),var_name.at(var).end());
 
+            // The value of an implicit time-dependent variable at the start of the time step
+            std::string old_var_name = {"old()"};
+            old_var_name.insert(--old_var_name.end(),var_name.at(var).begin(),var_name.at(var).end());
+
             if (split_dependency_list.at(dep) == var_name.at(var)){
                 need_value.at(var) = true;
                 dependency_entry_assigned = true;
@@ -164,6 +198,14 @@ void EquationDependencyParser::parseDependencyListRHS(std::vector<std::string> v
                     is_nonlinear = true;
                 }
             }
+            else if (split_dependency_list.at(dep) == old_var_name){
+                need_value_old.at(var) = true;
+                dependency_entry_assigned = true;
+                if ( (var_eq_type[var_index] == EXPLICIT_TIME_DEPENDENT) || (var_eq_type[var] != IMPLICIT_TIME_DEPENDENT) ){
+                    std::cerr << "PRISMS-PF Error: Dependency entry " << split_dependency_list.at(dep) << " is not valid because the old value can only be accessed for implicit time-dependent variables in the RHS of nonexplicit equations." << std::endl;
+                    abort();
+                }
+            }
         }
         if (!dependency_entry_assigned) {
             std::cerr << "PRISMS-PF Error: Dependency entry " << split_dependency_list.at(dep) << " is not valid." << std::endl;
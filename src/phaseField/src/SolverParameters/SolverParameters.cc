@@ -24,18 +24,60 @@ unsigned int SolverParametersBase::getEquationIndex(unsigned int global_index){
 void LinearSolverParameters::loadParameters(unsigned int _var_index,
     SolverToleranceType _tolerance_type,
     double _tolerance_value,
-    unsigned int _max_iterations){
+    unsigned int _max_iterations,
+    LinearSolverPreconditionerType _preconditioner_type,
+    unsigned int _chebyshev_degree,
+    double _chebyshev_smoothing_range,
+    LinearSolverInitialGuessType _initial_guess_type,
+    unsigned int _solve_interval,
+    double _solve_change_threshold,
+    PreconditionerPrecisionType _preconditioner_precision){
 
     var_index_list.push_back(_var_index);
     tolerance_type_list.push_back(_tolerance_type);
     tolerance_value_list.push_back(_tolerance_value);
     max_iterations_list.push_back(_max_iterations);
+    preconditioner_type_list.push_back(_preconditioner_type);
+    chebyshev_degree_list.push_back(_chebyshev_degree);
+    chebyshev_smoothing_range_list.push_back(_chebyshev_smoothing_range);
+    initial_guess_type_list.push_back(_initial_guess_type);
+    solve_interval_list.push_back(_solve_interval);
+    solve_change_threshold_list.push_back(_solve_change_threshold);
+    preconditioner_precision_list.push_back(_preconditioner_precision);
 }
 
 unsigned int LinearSolverParameters::getMaxIterations(unsigned int index){
     return max_iterations_list.at(getEquationIndex(index));
 }
 
+LinearSolverPreconditionerType LinearSolverParameters::getPreconditionerType(unsigned int index){
+    return preconditioner_type_list.at(getEquationIndex(index));
+}
+
+unsigned int LinearSolverParameters::getChebyshevDegree(unsigned int index){
+    return chebyshev_degree_list.at(getEquationIndex(index));
+}
+
+double LinearSolverParameters::getChebyshevSmoothingRange(unsigned int index){
+    return chebyshev_smoothing_range_list.at(getEquationIndex(index));
+}
+
+LinearSolverInitialGuessType LinearSolverParameters::getInitialGuessType(unsigned int index){
+    return initial_guess_type_list.at(getEquationIndex(index));
+}
+
+unsigned int LinearSolverParameters::getSolveInterval(unsigned int index){
+    return solve_interval_list.at(getEquationIndex(index));
+}
+
+double LinearSolverParameters::getSolveChangeThreshold(unsigned int index){
+    return solve_change_threshold_list.at(getEquationIndex(index));
+}
+
+PreconditionerPrecisionType LinearSolverParameters::getPreconditionerPrecision(unsigned int index){
+    return preconditioner_precision_list.at(getEquationIndex(index));
+}
+
 void NonlinearSolverParameters::loadParameters(unsigned int _var_index,
         SolverToleranceType _tolerance_type,
         double _tolerance_value,
@@ -43,7 +85,12 @@ void NonlinearSolverParameters::loadParameters(unsigned int _var_index,
         double _backtrack_step_modifier,
         double _backtrack_residual_decrease_coeff,
         double _default_dampling_coefficient,
-        bool _laplace_for_initial_guess){
+        bool _laplace_for_initial_guess,
+        NonlinearSolverType _solver_type,
+        double _initial_forcing_term,
+        double _max_forcing_term,
+        double _armijo_coeff,
+        unsigned int _anderson_depth){
 
     var_index_list.push_back(_var_index);
     tolerance_type_list.push_back(_tolerance_type);
@@ -53,6 +100,11 @@ void NonlinearSolverParameters::loadParameters(unsigned int _var_index,
     backtrack_residual_decrease_coeff_list.push_back(_backtrack_residual_decrease_coeff);
     default_damping_coefficient_list.push_back(_default_dampling_coefficient);
     laplace_for_initial_guess_list.push_back(_laplace_for_initial_guess);
+    solver_type_list.push_back(_solver_type);
+    initial_forcing_term_list.push_back(_initial_forcing_term);
+    max_forcing_term_list.push_back(_max_forcing_term);
+    armijo_coeff_list.push_back(_armijo_coeff);
+    anderson_depth_list.push_back(_anderson_depth);
 }
 
 bool NonlinearSolverParameters::getBacktrackDampingFlag(unsigned int index){
@@ -75,6 +127,26 @@ bool NonlinearSolverParameters::getLaplaceInitializationFlag(unsigned int index)
     return laplace_for_initial_guess_list.at(getEquationIndex(index));
 }
 
+NonlinearSolverType NonlinearSolverParameters::getSolverType(unsigned int index){
+    return solver_type_list.at(getEquationIndex(index));
+}
+
+double NonlinearSolverParameters::getInitialForcingTerm(unsigned int index){
+    return initial_forcing_term_list.at(getEquationIndex(index));
+}
+
+double NonlinearSolverParameters::getMaxForcingTerm(unsigned int index){
+    return max_forcing_term_list.at(getEquationIndex(index));
+}
+
+double NonlinearSolverParameters::getArmijoCoeff(unsigned int index){
+    return armijo_coeff_list.at(getEquationIndex(index));
+}
+
+unsigned int NonlinearSolverParameters::getAndersonDepth(unsigned int index){
+    return anderson_depth_list.at(getEquationIndex(index));
+}
+
 void NonlinearSolverParameters::setMaxIterations(unsigned int _max_iterations){
     max_iterations = _max_iterations;
 }
@@ -262,6 +262,15 @@ void inputFileReader::declare_parameters(dealii::ParameterHandler & parameter_ha
     parameter_handler.declare_entry("Number of time steps","-1",dealii::Patterns::Integer(),"The time step size for the simulation.");
     parameter_handler.declare_entry("Time step","-0.1",dealii::Patterns::Double(),"The time step size for the simulation.");
     parameter_handler.declare_entry("Simulation end time","-0.1",dealii::Patterns::Double(),"The value of simulated time where the simulation ends.");
+    parameter_handler.declare_entry("Adaptive time stepping","false",dealii::Patterns::Bool(),"Whether the time step is adjusted during the simulation based on an estimate of the time discretization error of the explicit fields. If true, 'Time step' is the initial time step.");
+    parameter_handler.declare_entry("Adaptive time stepping tolerance","1.0e-3",dealii::Patterns::Double(),"The target for the estimated local time discretization error of the explicit fields in each time step.");
+    parameter_handler.declare_entry("Maximum time step","-1",dealii::Patterns::Double(),"The largest time step allowed with adaptive time stepping (-1 sets it to the initial time step).");
+    parameter_handler.declare_entry("Stable time step","-1",dealii::Patterns::Double(),"The largest stable time step of the explicit fields on the initial mesh, used as a hard limit with adaptive time stepping (-1 sets it to the initial time step). If remeshing makes the smallest cell smaller, the limit is scaled by the square of the ratio of the cell sizes.");
+    parameter_handler.declare_entry("Minimum time step","-1",dealii::Patterns::Double(),"The smallest time step allowed with adaptive time stepping (-1 sets it to 0.01 times the initial time step).");
+    parameter_handler.declare_entry("Local time stepping groups","1",dealii::Patterns::Integer(),"The number of groups of cells, by refinement level, that the explicit fields are stepped in with their own time steps. The cells on the finest level take 'Time step', the cells n levels coarser take 2^n times it, and the last group holds all of the coarser cells (1 disables local time stepping). The steps of all of the groups only end together at the increments before every 2^(number of groups - 1)th increment. The steps between remeshing operations must therefore be a multiple of 2^(number of groups - 1), and the output and checkpoint increments must be one less than such a multiple. The nonexplicit fields are solved from the explicit fields at the mixed times of the groups in between.");
+
+    parameter_handler.declare_entry("Number of threads per process","1",dealii::Patterns::Integer(),"The maximum number of threads each MPI process uses for the matrix-free cell loops. The default of one thread per process matches a pure MPI run; larger values (or -1, which uses all available cores on every process) enable hybrid MPI and thread parallelism.");
+    parameter_handler.declare_entry("Share DoF handlers between fields","false",dealii::Patterns::Bool(),"Whether fields of the same type (scalar or vector) with the same periodic BCs share one finite element, DoF handler, and set of hanging node and periodicity constraints, instead of each field setting up its own. Fields that share a DoF handler also share one entry of the matrix-free object, so its DoF numbering and constraint data are only stored once. Consecutive scalar fields that share a DoF handler are then also evaluated together in the RHS cell loops.");
 
     for (unsigned int i=0; i<var_types.size(); i++){
         if (var_eq_types.at(i) == TIME_INDEPENDENT || var_eq_types.at(i) == IMPLICIT_TIME_DEPENDENT){
@@ -272,6 +281,13 @@ void inputFileReader::declare_parameters(dealii::ParameterHandler & parameter_ha
                 parameter_handler.declare_entry("Tolerance type","RELATIVE_RESIDUAL_CHANGE",dealii::Patterns::Anything(),"The tolerance type for the linear solver.");
                 parameter_handler.declare_entry("Tolerance value","1.0e-10",dealii::Patterns::Double(),"The value of for the linear solver tolerance.");
                 parameter_handler.declare_entry("Maximum linear solver iterations","1000",dealii::Patterns::Integer(),"The maximum number of linear solver iterations before the loop is stopped.");
+                parameter_handler.declare_entry("Preconditioner type","NONE",dealii::Patterns::Anything(),"The preconditioner for the linear solver (NONE, JACOBI, CHEBYSHEV, or MULTIGRID).");
+                parameter_handler.declare_entry("Chebyshev polynomial degree","5",dealii::Patterns::Integer(),"The degree of the Chebyshev polynomial (used with the Chebyshev preconditioner and as the multigrid smoother).");
+                parameter_handler.declare_entry("Chebyshev smoothing range","20.0",dealii::Patterns::Double(),"The ratio between the largest and smallest eigenvalues targeted by the Chebyshev preconditioner (or smoother).");
+                parameter_handler.declare_entry("Preconditioner precision","DOUBLE",dealii::Patterns::Anything(),"The precision the inverse of the LHS diagonal is stored in for the Jacobi and Chebyshev preconditioners (DOUBLE or SINGLE). It is always computed and applied in double precision. This only affects the preconditioner: the field solutions, residuals and LHS products are always in double precision.");
+                parameter_handler.declare_entry("Initial guess","ZERO",dealii::Patterns::Anything(),"The initial guess for the change in the solution in the first linear solve of each time step (ZERO, PREVIOUS_CHANGE, LINEAR_EXTRAPOLATION, or QUADRATIC_EXTRAPOLATION).");
+                parameter_handler.declare_entry("Solve interval","1",dealii::Patterns::Integer(),"The maximum number of increments between solves of a time-independent field. Between the solves the previous solution is reused (a field with time-dependent non-uniform Dirichlet BCs is solved every increment).");
+                parameter_handler.declare_entry("Solve change threshold","0.0",dealii::Patterns::Double(),"The largest change in the fields a time-independent field depends on (since its last solve) for which its solve is skipped. Zero turns off the check, so the field is solved every 'Solve interval' increments.");
             }
             parameter_handler.leave_subsection();
         }
@@ -286,12 +302,17 @@ void inputFileReader::declare_parameters(dealii::ParameterHandler & parameter_ha
             subsection_text.append(var_names.at(i));
             parameter_handler.enter_subsection(subsection_text);
             {
+                parameter_handler.declare_entry("Nonlinear solver type","DAMPED_ITERATION",dealii::Patterns::Anything(),"The nonlinear solver (DAMPED_ITERATION or NEWTON_KRYLOV). NEWTON_KRYLOV is an inexact Newton method for time-independent and implicit time-dependent equations, with the LHS as the Jacobian, Eisenstat-Walker linear tolerances, and an Armijo line search.");
                 parameter_handler.declare_entry("Tolerance type","ABSOLUTE_SOLUTION_CHANGE",dealii::Patterns::Anything(),"The tolerance type for the nonlinear solver.");
                 parameter_handler.declare_entry("Tolerance value","1.0e-10",dealii::Patterns::Double(),"The value of for the nonlinear solver tolerance.");
                 parameter_handler.declare_entry("Use backtracking line search damping","true",dealii::Patterns::Bool(),"Whether to use a backtracking line-search to find the best choice of the damping coefficient.");
                 parameter_handler.declare_entry("Backtracking step size modifier","0.5",dealii::Patterns::Double(),"The constant that determines how much the step size decreases per backtrack. The 'tau' parameter.");
                 parameter_handler.declare_entry("Backtracking residual decrease coefficient","1.0",dealii::Patterns::Double(),"The constant that determines how much the residual must decrease to be accepted as sufficient. The 'c' parameter.");
                 parameter_handler.declare_entry("Constant damping value","1.0",dealii::Patterns::Double(),"The constant damping value to be used if the backtrace line-search approach isn't used.");
+                parameter_handler.declare_entry("Initial forcing term","0.1",dealii::Patterns::Double(),"The linear solver tolerance of the first Newton-Krylov step, relative to the residual (the Eisenstat-Walker forcing term is used after that).");
+                parameter_handler.declare_entry("Maximum forcing term","0.9",dealii::Patterns::Double(),"The upper bound of the Eisenstat-Walker forcing term for the Newton-Krylov solver.");
+                parameter_handler.declare_entry("Armijo sufficient decrease coefficient","1.0e-4",dealii::Patterns::Double(),"The fraction of the decrease in the residual predicted by the linear solve that a Newton-Krylov step must achieve to be accepted by the line search.");
+                parameter_handler.declare_entry("Anderson acceleration depth","0",dealii::Patterns::Integer(),"The number of previous iterates mixed into each fixed-point iteration of a nonlinear auxiliary equation by Anderson acceleration (0 for plain fixed-point iterations).");
                 parameter_handler.declare_entry("Use Laplace's equation to determine the initial guess","false",dealii::Patterns::Bool(),"Whether to use the solution of Laplace's equation instead of the IC in ICs_and_BCs.cc as the initial guess for nonlinear, time independent equations. This guarantees smoothness and compliance with BCs.");
             }
             parameter_handler.leave_subsection();
@@ -344,6 +365,7 @@ void inputFileReader::declare_parameters(dealii::ParameterHandler & parameter_ha
         }
 
     }
+    parameter_handler.declare_entry("Time-dependent non-uniform Dirichlet BCs","false",dealii::Patterns::Bool(),"Whether the non-uniform Dirichlet BCs depend on time, so that their values are updated every time step (only the values at the cached boundary DOFs are re-evaluated, the constraints aren't rebuilt). Otherwise they are only evaluated when the mesh changes.");
 
     // Declare the nucleation parameters
     parameter_handler.declare_entry("Minimum allowed distance between nuclei","-1",dealii::Patterns::Double(),"The minimum allowed distance between nuclei placed during the same time step.");
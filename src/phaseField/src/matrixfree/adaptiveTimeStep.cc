@@ -0,0 +1,187 @@
+// Methods for adaptive time stepping and the output/checkpoint schedule for the MatrixFreePDE class
+
+#include "../../include/matrixFreePDE.h"
+
+// Set the time step for the next increment. With adaptive time stepping, the nominal time step is shortened (and
+// split evenly over the remaining increments) so that the increments land exactly on the next output, checkpoint,
+// or the final time.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setTimeStepForNextIncrement(){
+
+    if (!userInputs.adaptive_time_stepping){
+        return;
+    }
+
+    double next_event_time = userInputs.finalTime;
+    if (currentOutput < userInputs.outputTimeList.size()){
+        next_event_time = std::min(next_event_time, userInputs.outputTimeList[currentOutput]);
+    }
+    if (currentCheckpoint < userInputs.checkpointTimeList.size()){
+        next_event_time = std::min(next_event_time, userInputs.checkpointTimeList[currentCheckpoint]);
+    }
+
+    double time_to_next_event = next_event_time - currentTime;
+    if (time_to_next_event > 1.0e-6*nominal_dtValue){
+        double num_increments_to_next_event = std::ceil(time_to_next_event/nominal_dtValue - 1.0e-6);
+        userInputs.dtValue = time_to_next_event/num_increments_to_next_event;
+    }
+    else {
+        userInputs.dtValue = nominal_dtValue;
+    }
+}
+
+// Estimate the local error of the forward Euler update in the last time step from the change in the rate of change
+// of the explicit fields between the last two time steps (err ~ dt^2/2 |d^2u/dt^2|)
+template <int dim, int degree>
+double MatrixFreePDE<dim,degree>::adaptiveTimeStepErrorEstimate() const {
+    return max_rate_change*userInputs.dtValue*userInputs.dtValue/(userInputs.dtValue+previous_dtValue);
+}
+
+// Check the time step that was just taken. If its error estimate is over the tolerance (and the time step can still be
+// shortened), the time-dependent fields are reset to the start of the time step and the time step is shortened, so the
+// increment can be solved again.
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::rejectAdaptiveTimeStep(){
+
+    // The first increment (and the first one after remeshing) has no error estimate
+    if (!userInputs.adaptive_time_stepping || !explicit_rates_set){
+        return false;
+    }
+
+    double error_estimate = adaptiveTimeStepErrorEstimate();
+    if (error_estimate <= userInputs.adaptive_time_step_tolerance || userInputs.dtValue <= userInputs.min_dtValue*(1.0+1.0e-12)){
+        return false;
+    }
+
+    const double safety_factor = 0.9;
+    const double max_decrease = 0.5;
+    double dt_factor = std::max(max_decrease, safety_factor*std::sqrt(userInputs.adaptive_time_step_tolerance/error_estimate));
+
+    pcout << "adaptive time step: error estimate: " << error_estimate << " is over the tolerance, redoing the time step with a time step of " << std::max(userInputs.min_dtValue, userInputs.dtValue*dt_factor) << "\n";
+
+    // Reset the explicit and implicit time-dependent fields to the start of the time step (the other fields are solved
+    // again from them)
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        if (explicitStepStartSet[fieldIndex] != NULL){
+            *solutionSet[fieldIndex] = *explicitStepStartSet[fieldIndex];
+            solutionSet[fieldIndex]->update_ghost_values();
+        }
+        else if (oldSolutionSet[fieldIndex] != NULL){
+            *solutionSet[fieldIndex] = *oldSolutionSet[fieldIndex];
+            solutionSet[fieldIndex]->update_ghost_values();
+        }
+
+        // A time-independent field solved in the rejected step can't reuse that solution
+        if (lastSolveIncrementSet[fieldIndex] == (int)currentIncrement){
+            lastSolveIncrementSet[fieldIndex] = -1;
+        }
+    }
+
+    currentTime -= userInputs.dtValue;
+    nominal_dtValue = std::max(userInputs.min_dtValue, userInputs.dtValue*dt_factor);
+    setTimeStepForNextIncrement();
+    currentTime += userInputs.dtValue;
+
+    // Update the values of the time-dependent non-uniform Dirichlet BCs for the new time
+    if (userInputs.time_dependent_nonuniform_BCs){
+        updateNonUniformDirichletBCs();
+    }
+
+    return true;
+}
+
+// Pick the nominal time step for the next increment from the error estimate of the time step that was just accepted.
+// The time step is scaled toward the tolerance, with the growth and reduction per increment limited so the step size
+// changes smoothly, and it is capped by the stability limit of the explicit fields. The rates of change over the
+// accepted time step are then stored for the next error estimate.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateAdaptiveTimeStep(){
+
+    if (!userInputs.adaptive_time_stepping){
+        return;
+    }
+
+    // The first increment (and the first one after remeshing) only records the rates of change
+    if (explicit_rates_set){
+        double error_estimate = adaptiveTimeStepErrorEstimate();
+
+        const double safety_factor = 0.9;
+        const double max_increase = 1.25;
+        const double max_decrease = 0.5;
+
+        double dt_factor = max_increase;
+        if (error_estimate > 0.0){
+            dt_factor = safety_factor*std::sqrt(userInputs.adaptive_time_step_tolerance/error_estimate);
+        }
+        dt_factor = std::max(max_decrease, std::min(max_increase, dt_factor));
+
+        nominal_dtValue = std::min(userInputs.max_dtValue, std::min(stable_dtValue, nominal_dtValue*dt_factor));
+        nominal_dtValue = std::max(userInputs.min_dtValue, nominal_dtValue);
+
+        if (currentIncrement%userInputs.skip_print_steps==0){
+            pcout << "adaptive time step: error estimate: " << error_estimate << "  next time step: " << nominal_dtValue << "\n";
+        }
+    }
+
+    const double inv_dt = 1.0/userInputs.dtValue;
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        if (explicitRateSet[fieldIndex] != NULL){
+            double * rate = explicitRateSet[fieldIndex]->begin();
+            const double * solution = solutionSet[fieldIndex]->begin();
+            const double * step_start = explicitStepStartSet[fieldIndex]->begin();
+            const unsigned int local_size = explicitRateSet[fieldIndex]->local_size();
+            for (unsigned int dof=0; dof<local_size; ++dof){
+                rate[dof] = (solution[dof]-step_start[dof])*inv_dt;
+            }
+        }
+    }
+
+    previous_dtValue = userInputs.dtValue;
+    explicit_rates_set = true;
+}
+
+// Scale the declared stable time step to the smallest cell of the current mesh. It is declared for the smallest cell
+// at the start of the time stepping, and the limit on the explicit (diffusive) terms shrinks with the square of the
+// cell size when remeshing refines past it.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateStableTimeStep(){
+
+    if (!userInputs.adaptive_time_stepping){
+        return;
+    }
+
+    double min_cell_diameter = Utilities::MPI::min(GridTools::minimal_cell_diameter(triangulation), MPI_COMM_WORLD);
+    if (stable_dt_min_cell_diameter < 0.0){
+        stable_dt_min_cell_diameter = min_cell_diameter;
+    }
+
+    double cell_size_ratio = std::min(1.0, min_cell_diameter/stable_dt_min_cell_diameter);
+    stable_dtValue = userInputs.stable_dtValue*cell_size_ratio*cell_size_ratio;
+    nominal_dtValue = std::min(nominal_dtValue, stable_dtValue);
+}
+
+// Check whether the output or checkpoint at list_index in a schedule is due in the current increment
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::scheduledEventDue(const std::vector<unsigned int> & increment_list, const std::vector<double> & time_list, unsigned int list_index) const {
+
+    if (userInputs.adaptive_time_stepping){
+        return (list_index < time_list.size() && currentTime > time_list[list_index] - 1.0e-6*nominal_dtValue);
+    }
+    else {
+        return (list_index < increment_list.size() && increment_list[list_index] == currentIncrement);
+    }
+}
+
+// Check whether the time stepping has reached the end of the simulation
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::timeSteppingComplete() const {
+
+    if (userInputs.adaptive_time_stepping){
+        return (currentTime > userInputs.finalTime - 1.0e-6*nominal_dtValue);
+    }
+    else {
+        return (currentIncrement > userInputs.totalIncrements);
+    }
+}
+
+#include "../../include/matrixFreePDE_template_instantiations.h"
@@ -4,20 +4,24 @@
 #include "../../include/vectorBCFunction.h"
 #include "../../include/varBCs.h"
 #include "../../include/nonUniformDirichletBC.h"
+#include <deal.II/fe/mapping_q1.h>
+#include <set>
 
 // =================================================================================
 // Methods to apply non-zero Neumann BCs
 // =================================================================================
+// Assemble the boundary integral of each shape function times the Neumann value for the faces with a Neumann BC.
+// The terms are distributed through the hanging node and periodicity constraints like the cell residuals, and
+// only the nonzero terms at the locally owned DOFs are kept. The terms from the cells in each local time stepping
+// group are kept separately, since each group can be advanced by a different time step.
 template <int dim, int degree>
-void MatrixFreePDE<dim,degree>::applyNeumannBCs(){
-	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-	// NOTE: Currently this function doesn't work and it's call is commented out in solveIncrement.
-	// The result is off by almost exactly a factor of 100,000. I don't know what the issue is.
-	// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+void MatrixFreePDE<dim,degree>::setNeumannBCs(unsigned int fieldIndex){
+	const unsigned int n_groups = timeStepGroupFactor.size();
+	localNeumannDoFSet[fieldIndex].assign(n_groups, std::vector<unsigned int>());
+	neumannTermSet[fieldIndex].assign(n_groups, std::vector<double>());
 
-	// Check to the BC for the current field
 	unsigned int starting_BC_list_index = 0;
-	for (unsigned int i=0; i<currentFieldIndex; i++){
+	for (unsigned int i=0; i<fieldIndex; i++){
 		if (userInputs.var_type[i] == SCALAR){
 			starting_BC_list_index++;
 		}
@@ -25,48 +29,115 @@ void MatrixFreePDE<dim,degree>::applyNeumannBCs(){
 			starting_BC_list_index+=dim;
 		}
 	}
+	unsigned int n_components = (userInputs.var_type[fieldIndex] == SCALAR) ? 1 : dim;
 
-	if (userInputs.var_type[currentFieldIndex] == SCALAR){
-		for (unsigned int direction = 0; direction < 2*dim; direction++){
-			if (userInputs.BC_list[starting_BC_list_index].var_BC_type[direction] == NEUMANN){
-
-				typename DoFHandler<dim>::active_cell_iterator cell = dofHandlersSet[0]->begin_active(), endc = dofHandlersSet[0]->end();
-				FESystem<dim>* fe= FESet[currentFieldIndex];
-				QGaussLobatto<dim-1>  face_quadrature_formula(degree+1);
-				FEFaceValues<dim> fe_face_values (*fe, face_quadrature_formula, update_values | update_JxW_values);
-				const unsigned int n_face_q_points  = face_quadrature_formula.size(), dofs_per_cell=fe->dofs_per_cell;
-				Vector<double> cell_rhs(dofs_per_cell);
-				std::vector<types::global_dof_index> local_dof_indices (dofs_per_cell);
-
-				// Loop over each face on a boundary
-				for (;cell!=endc; ++cell){
-					for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f){
-						if (cell->face(f)->at_boundary()){
-							if (cell->face(f)->boundary_id() == direction){
-								fe_face_values.reinit (cell, f);
-								cell_rhs=0.0;
-								for (unsigned int q_point=0; q_point<n_face_q_points; ++q_point){
-									double neumann_value = userInputs.BC_list[starting_BC_list_index].var_BC_val[direction];
-									for (unsigned int i=0; i<dofs_per_cell; ++i){
-										cell_rhs(i) += (neumann_value * fe_face_values.shape_value(i,q_point) * fe_face_values.JxW(q_point));
-									}
-								}
-								cell->get_dof_indices (local_dof_indices);
-								//assemble
-								for (unsigned int i=0; i<dofs_per_cell; ++i){
-									(*(residualSet[currentFieldIndex]))[local_dof_indices[i]] += cell_rhs(i);
-								}
-							}
-						}
+	bool has_neumann_BCs = false;
+	for (unsigned int component=0; component<n_components; component++){
+		for (unsigned int direction=0; direction<2*dim; direction++){
+			if (userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] == NEUMANN){
+				has_neumann_BCs = true;
+			}
+		}
+	}
+	if (!has_neumann_BCs){
+		return;
+	}
+
+	std::vector<vectorType> neumann_terms(n_groups);
+	for (unsigned int group=0; group<n_groups; group++){
+		matrixFreeObject.initialize_dof_vector(neumann_terms[group], dofIndexSet[fieldIndex]);
+		neumann_terms[group] = 0.0;
+	}
+
+	const FESystem<dim> & fe = *FESet[fieldIndex];
+	QGaussLobatto<dim-1> face_quadrature_formula(degree+1);
+	FEFaceValues<dim> fe_face_values (fe, face_quadrature_formula, update_values | update_JxW_values);
+	const unsigned int n_face_q_points = face_quadrature_formula.size(), dofs_per_cell = fe.dofs_per_cell;
+	Vector<double> cell_rhs(dofs_per_cell);
+	std::vector<types::global_dof_index> local_dof_indices (dofs_per_cell);
+
+	// Loop over each locally owned cell face on a boundary with a Neumann BC (through the cell batches of the matrixFreeObject, which hold the locally owned cells)
+	for (unsigned int batch=0; batch<matrixFreeObject.n_macro_cells(); ++batch){
+		const unsigned int group = cellBatchTimeStepGroup[batch];
+		for (unsigned int v=0; v<matrixFreeObject.n_components_filled(batch); ++v){
+			typename DoFHandler<dim>::cell_iterator cell = matrixFreeObject.get_cell_iterator(batch, v, dofIndexSet[fieldIndex]);
+
+			for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f){
+				if (!cell->face(f)->at_boundary()){
+					continue;
+				}
+				unsigned int direction = cell->face(f)->boundary_id();
+				if (direction >= 2*dim){
+					continue;
+				}
+
+				bool neumann_face = false;
+				for (unsigned int component=0; component<n_components; component++){
+					if (userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] == NEUMANN){
+						neumann_face = true;
 					}
 				}
-			}
+				if (!neumann_face){
+					continue;
+				}
 
+				fe_face_values.reinit (cell, f);
+				cell_rhs = 0.0;
+				for (unsigned int i=0; i<dofs_per_cell; ++i){
+					const unsigned int component = fe.system_to_component_index(i).first;
+					if (userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] != NEUMANN){
+						continue;
+					}
+					double neumann_value = userInputs.BC_list[starting_BC_list_index+component].var_BC_val[direction];
+					for (unsigned int q_point=0; q_point<n_face_q_points; ++q_point){
+						cell_rhs(i) += neumann_value * fe_face_values.shape_value(i,q_point) * fe_face_values.JxW(q_point);
+					}
+				}
+				cell->get_dof_indices (local_dof_indices);
+				constraintsOtherSet[fieldIndex]->distribute_local_to_global(cell_rhs, local_dof_indices, neumann_terms[group]);
+			}
 		}
 	}
 
+	for (unsigned int group=0; group<n_groups; group++){
+		neumann_terms[group].compress(VectorOperation::add);
+
+		for (unsigned int dof=0; dof<neumann_terms[group].local_size(); ++dof){
+			if (neumann_terms[group].local_element(dof) != 0.0){
+				localNeumannDoFSet[fieldIndex][group].push_back(dof);
+				neumannTermSet[fieldIndex][group].push_back(neumann_terms[group].local_element(dof));
+			}
+		}
+	}
 }
 
+// Add the Neumann BC terms to the residual of a field. The residuals of the time-dependent equations are the change
+// over one time step, so the terms are multiplied by the time step for them (and for the explicit equations, by the
+// multiple of the time step that each local time stepping group is advanced by).
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::applyNeumannBCs(unsigned int fieldIndex){
+	double * residual_ptr = residualSet[fieldIndex]->begin();
+
+	for (unsigned int group=0; group<localNeumannDoFSet[fieldIndex].size(); group++){
+		const std::vector<unsigned int> & neumann_dofs = localNeumannDoFSet[fieldIndex][group];
+		if (neumann_dofs.size() == 0){
+			continue;
+		}
+
+		double scale = 1.0;
+		if (fields[fieldIndex].pdetype == EXPLICIT_TIME_DEPENDENT){
+			scale = userInputs.dtValue*timeStepGroupFactor[group];
+		}
+		else if (fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT){
+			scale = userInputs.dtValue;
+		}
+
+		const std::vector<double> & neumann_terms = neumannTermSet[fieldIndex][group];
+		for (unsigned int k=0; k<neumann_dofs.size(); k++){
+			residual_ptr[neumann_dofs[k]] += scale*neumann_terms[k];
+		}
+	}
+}
 
 // =================================================================================
 // Methods to apply non-zero Dirichlet BCs
@@ -146,6 +217,112 @@ void MatrixFreePDE<dim,degree>::applyDirichletBCs(){
 	  }
 }
 
+// Check whether any component of a field has a non-uniform Dirichlet BC on any boundary
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::hasNonUniformDirichletBCs(unsigned int fieldIndex) const {
+
+	unsigned int starting_BC_list_index = 0;
+	for (unsigned int i=0; i<fieldIndex; i++){
+		if (userInputs.var_type[i] == SCALAR){
+			starting_BC_list_index++;
+		}
+		else {
+			starting_BC_list_index+=dim;
+		}
+	}
+	unsigned int n_components = (userInputs.var_type[fieldIndex] == SCALAR) ? 1 : dim;
+
+	for (unsigned int component=0; component<n_components; component++){
+		for (unsigned int direction=0; direction<2*dim; direction++){
+			if (userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] == NON_UNIFORM_DIRICHLET){
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Find the DOFs constrained by non-uniform Dirichlet BCs for a field and their support points. As in
+// interpolate_boundary_values, a DOF on more than one boundary keeps the BC of the first one it was constrained for.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setNonUniformDirichletDoFs(unsigned int fieldIndex){
+	nonUniformDirichletDoFSet[fieldIndex].clear();
+
+	if (!hasNonUniformDirichletBCs(fieldIndex)){
+		return;
+	}
+
+	unsigned int starting_BC_list_index = 0;
+	for (unsigned int i=0; i<fieldIndex; i++){
+		if (userInputs.var_type[i] == SCALAR){
+			starting_BC_list_index++;
+		}
+		else {
+			starting_BC_list_index+=dim;
+		}
+	}
+	unsigned int n_components = (userInputs.var_type[fieldIndex] == SCALAR) ? 1 : dim;
+
+	std::map<types::global_dof_index, Point<dim> > support_points;
+	DoFTools::map_dofs_to_support_points(MappingQ1<dim>(), *dofHandlersSet[fieldIndex], support_points);
+
+	std::set<types::global_dof_index> claimed_dofs;
+	for (unsigned int direction=0; direction<2*dim; direction++){
+		std::vector<types::global_dof_index> direction_dofs;
+		for (unsigned int component=0; component<n_components; component++){
+			BC_type bc_type = userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction];
+			if (bc_type != DIRICHLET && bc_type != NON_UNIFORM_DIRICHLET){
+				continue;
+			}
+
+			ComponentMask mask(n_components,false);
+			mask.set(component,true);
+			std::set<types::boundary_id> boundary_ids;
+			boundary_ids.insert(direction);
+			IndexSet boundary_dofs;
+			DoFTools::extract_boundary_dofs(*dofHandlersSet[fieldIndex], mask, boundary_dofs, boundary_ids);
+
+			for (unsigned int k=0; k<boundary_dofs.n_elements(); k++){
+				types::global_dof_index dof = boundary_dofs.nth_index_in_set(k);
+				if (claimed_dofs.count(dof) > 0 || !constraintsDirichletSet[fieldIndex]->is_constrained(dof)){
+					continue;
+				}
+				direction_dofs.push_back(dof);
+
+				typename std::map<types::global_dof_index, Point<dim> >::const_iterator point = support_points.find(dof);
+				if (bc_type == NON_UNIFORM_DIRICHLET && point != support_points.end()){
+					nonUniformDirichletDoF cached_dof;
+					cached_dof.dof_index = dof;
+					cached_dof.support_point = point->second;
+					cached_dof.direction = direction;
+					cached_dof.component = component;
+					nonUniformDirichletDoFSet[fieldIndex].push_back(cached_dof);
+				}
+			}
+		}
+		claimed_dofs.insert(direction_dofs.begin(),direction_dofs.end());
+	}
+}
+
+// Re-evaluate the non-uniform Dirichlet BCs at the cached DOFs for the current time. Only the inhomogeneities of the
+// Dirichlet constraints change, so the constraints don't have to be rebuilt.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateNonUniformDirichletBCs(){
+	for (unsigned int fieldIndex=0; fieldIndex<nonUniformDirichletDoFSet.size(); fieldIndex++){
+		const std::vector<nonUniformDirichletDoF> & cached_dofs = nonUniformDirichletDoFSet[fieldIndex];
+		bool is_scalar = (userInputs.var_type[fieldIndex] == SCALAR);
+
+		double scalar_BC = 0.0;
+		dealii::Vector<double> vector_BC(dim);
+		for (unsigned int k=0; k<cached_dofs.size(); k++){
+			setNonUniformDirichletBCs(cached_dofs[k].support_point, fieldIndex, cached_dofs[k].direction, currentTime, scalar_BC, vector_BC);
+			double value = is_scalar ? scalar_BC : vector_BC(cached_dofs[k].component);
+
+			constraintsDirichletSet_nonconst[fieldIndex]->set_inhomogeneity(cached_dofs[k].dof_index, value);
+		}
+	}
+}
+
 // Based on the contents of BC_list, mark faces on the triangulation as periodic
 template <int dim, int degree>
 void MatrixFreePDE<dim,degree>::setPeriodicity(){
@@ -267,4 +444,27 @@ void MatrixFreePDE<dim,degree>::setRigidBodyModeConstraints(const std::vector<in
    }
 }
 
+// Set the entries of a vector at the locally owned Dirichlet DOFs of a field to zero
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::zeroDirichletDoFs(vectorType & vec, unsigned int fieldIndex) const {
+	const std::vector<unsigned int> & dirichlet_dofs = localDirichletDoFSet[fieldIndex];
+	const unsigned int n_dirichlet_dofs = dirichlet_dofs.size();
+	double * vec_ptr = vec.begin();
+	for (unsigned int k=0; k<n_dirichlet_dofs; k++){
+		vec_ptr[dirichlet_dofs[k]] = 0.0;
+	}
+}
+
+// Copy the entries of src at the locally owned Dirichlet DOFs of a field into dst
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::copyDirichletDoFs(vectorType & dst, const vectorType & src, unsigned int fieldIndex) const {
+	const std::vector<unsigned int> & dirichlet_dofs = localDirichletDoFSet[fieldIndex];
+	const unsigned int n_dirichlet_dofs = dirichlet_dofs.size();
+	double * dst_ptr = dst.begin();
+	const double * src_ptr = src.begin();
+	for (unsigned int k=0; k<n_dirichlet_dofs; k++){
+		dst_ptr[dirichlet_dofs[k]] = src_ptr[dirichlet_dofs[k]];
+	}
+}
+
 #include "../../include/matrixFreePDE_template_instantiations.h"
@@ -46,7 +46,11 @@ void MatrixFreePDE<dim,degree>::save_checkpoint(){
             }
         }
 
-        // Second, build one solution set list for scalars and one for vectors
+        // Second, build one solution set list for scalars and one for vectors (the transfer needs the ghost values,
+        // which aren't kept up to date for the explicit fields between time steps)
+        for(unsigned int var = 0; var < userInputs.number_of_variables; ++var){
+            solutionSet[var]->update_ghost_values();
+        }
         std::vector<const vectorType *> solSet_transfer_scalars;
         std::vector<const vectorType *> solSet_transfer_vectors;
         for(unsigned int var = 0; var < userInputs.number_of_variables; ++var){
@@ -40,19 +40,49 @@ void  MatrixFreePDE<dim,degree>::computeIntegral(double& integratedField, int in
 
 //-----------------------------------
 
-//update RHS of each field
+// Integrate a single field over the domain using the matrix-free framework
 template <int dim, int degree>
 void MatrixFreePDE<dim,degree>::computeIntegralMF(double& integratedField, int index, const std::vector<vectorType*> variableSet){
+
+  std::vector<vectorType*> integrated_set(1,variableSet[index]);
+  std::vector<unsigned int> dof_handler_indices(1,index);
+  std::vector<double> integrated_fields;
+
+  computeIntegralsMF(integrated_fields, dof_handler_indices, integrated_set);
+
+  integratedField = integrated_fields[0];
+}
+
+// Integrate any number of scalar fields over the domain in a single pass over the cells. Each entry of variableSet
+// is integrated using the DoFHandler of the field given by the matching entry of dof_handler_indices.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::computeIntegralsMF(std::vector<double>& integratedFields, const std::vector<unsigned int>& dof_handler_indices, const std::vector<vectorType*> variableSet){
   //log time
   computing_timer.enter_section("matrixFreePDE: computeIntegralMF");
 
-  integrated_var = 0.0;
-  integral_index = index;
+  if (dof_handler_indices.size() != variableSet.size()){
+      std::cerr << "PRISMS-PF Error: The number of DoFHandler indices given for the integration must match the number of fields to be integrated." << std::endl;
+      abort();
+  }
+  for (unsigned int i=0; i<dof_handler_indices.size(); i++){
+      if (dofHandlersSet[dof_handler_indices[i]]->get_fe().n_components() != 1){
+          std::cerr << "PRISMS-PF Error: Only scalar fields can be integrated." << std::endl;
+          abort();
+      }
+  }
+
+  integrated_vars.assign(variableSet.size(),0.0);
+  integral_dof_handler_indices.resize(dof_handler_indices.size());
+  for (unsigned int i=0; i<dof_handler_indices.size(); i++){
+      integral_dof_handler_indices[i] = dofIndexSet[dof_handler_indices[i]];
+  }
 
   //call to integrate and assemble
   matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getIntegralMF, this, residualSet, variableSet);
 
-  integratedField=Utilities::MPI::sum(integrated_var, MPI_COMM_WORLD);
+  // A single reduction over the processors for all of the integrals
+  integratedFields.resize(variableSet.size());
+  Utilities::MPI::sum(integrated_vars, MPI_COMM_WORLD, integratedFields);
 
   //end log
   computing_timer.exit_section("matrixFreePDE: computeIntegralMF");
@@ -64,34 +94,46 @@ void MatrixFreePDE<dim,degree>::getIntegralMF(const MatrixFree<dim,double> &data
                                         const std::vector<vectorType*> &src,
                                         const std::pair<unsigned int,unsigned int> &cell_range) {
 
-	dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data,0);
+    // The partial sums for this range of cells are kept per SIMD lane and are only added to the shared totals
+    // once at the end, so the threads don't contend for the lock inside the loops over the cells
+    std::vector<dealii::VectorizedArray<double> > partial_sums(src.size(),dealii::make_vectorized_array(0.0));
 
-    //loop over cells
-    for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
-		var.reinit(cell);
-		var.read_dof_values_plain(*src[0]);
-		var.evaluate(true, false, false);
+    for (unsigned int i=0; i<src.size(); i++){
+
+        dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data,integral_dof_handler_indices[i]);
 
         unsigned int num_q_points = var.n_q_points;
+        dealii::AlignedVector<dealii::VectorizedArray<double> > JxW(num_q_points);
 
-		dealii::AlignedVector<dealii::VectorizedArray<double> > JxW(num_q_points);
-		var.fill_JxW_values(JxW);
+        //loop over cells
+        for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
+            var.reinit(cell);
+            var.read_dof_values_plain(*src[i]);
+            var.evaluate(true, false, false);
 
-        //loop over quadrature points
-        for (unsigned int q=0; q<num_q_points; ++q){
+            var.fill_JxW_values(JxW);
 
+            dealii::VectorizedArray<double> cell_sum = dealii::make_vectorized_array(0.0);
 
-			dealii::VectorizedArray<double> val = var.get_value(q);
-			assembler_lock.acquire ();
-			for (unsigned i=0; i<val.n_array_elements;i++){
-				integrated_var += val[i]*JxW[q][i];
-			}
-			assembler_lock.release ();
+            //loop over quadrature points
+            for (unsigned int q=0; q<num_q_points; ++q){
+                cell_sum += var.get_value(q)*JxW[q];
+            }
 
+            // Only count the lanes that hold an actual cell
+            for (unsigned int v=0; v<data.n_components_filled(cell); v++){
+                partial_sums[i][v] += cell_sum[v];
+            }
         }
+    }
 
-
+    assembler_lock.acquire ();
+    for (unsigned int i=0; i<src.size(); i++){
+        for (unsigned int v=0; v<dealii::VectorizedArray<double>::n_array_elements; v++){
+            integrated_vars[i] += partial_sums[i][v];
+        }
     }
+    assembler_lock.release ();
 }
 
 #include "../../include/matrixFreePDE_template_instantiations.h"
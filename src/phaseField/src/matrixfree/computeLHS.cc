@@ -18,11 +18,7 @@ void MatrixFreePDE<dim,degree>::vmult (vectorType &dst, const vectorType &src) c
   }
 
   //Account for Dirichlet BC's (essentially copy dirichlet DOF values present in src to dst, although it is unclear why the constraints can't just be distributed here)
-  for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[currentFieldIndex]->begin(); it!=valuesDirichletSet[currentFieldIndex]->end(); ++it){
-    if (dst.in_local_range(it->first)){
-      dst(it->first) = src(it->first); //*jacobianDiagonal(it->first);
-    }
-  }
+  copyDirichletDoFs(dst, src, currentFieldIndex);
 
   //end log
   computing_timer.exit_section("matrixFreePDE: computeLHS");
@@ -35,14 +31,24 @@ void  MatrixFreePDE<dim,degree>::getLHS(const MatrixFree<dim,double> &data,
 				 const vectorType &src,
 				 const std::pair<unsigned int,unsigned int> &cell_range) const{
 
-    variableContainer<dim,degree,dealii::VectorizedArray<double> > variable_list(data,userInputs.varInfoListLHS,userInputs.varChangeInfoListLHS);
+    getLHSForSolution(data,dst,src,solutionSet,cell_range);
+}
+
+template <int dim, int degree>
+void  MatrixFreePDE<dim,degree>::getLHSForSolution(const MatrixFree<dim,double> &data,
+				 vectorType &dst,
+				 const vectorType &src,
+				 const std::vector<vectorType*> &solution_set,
+				 const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+    variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,userInputs.varInfoListLHS,&userInputs.varChangeInfoListLHS);
 
 	//loop over cells
 	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
 
 		// Initialize, read DOFs, and set evaulation flags for each variable
         //variable_list.reinit_and_eval_LHS(src,solutionSet,cell,currentFieldIndex);
-        variable_list.reinit_and_eval(solutionSet,cell);
+        variable_list.reinit_and_eval(solution_set,cell);
         variable_list.reinit_and_eval_change_in_solution(src,cell,currentFieldIndex);
 
 		unsigned int num_q_points = variable_list.get_num_q_points();
@@ -64,4 +70,97 @@ void  MatrixFreePDE<dim,degree>::getLHS(const MatrixFree<dim,double> &data,
 	}
 }
 
+// Compute the inverse of the diagonal of the LHS for the given field (used by the Jacobi and Chebyshev preconditioners)
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::computeInvLHSDiagonal(unsigned int fieldIndex){
+  //log time
+  computing_timer.enter_section("matrixFreePDE: computeLHSDiagonal");
+
+  currentFieldIndex = fieldIndex; // Used in getLHSDiagonal()
+
+  // With a single precision preconditioner, the diagonal is assembled and inverted in a double precision scratch vector and then copied
+  vectorType & invDiagonal = (invLHSDiagonalSingleSet[fieldIndex] != NULL) ? getScratchVector(fieldIndex, 0) : *invLHSDiagonalSet[fieldIndex];
+  invDiagonal = 0.0;
+
+  // The src vector isn't used, the change in the solution is set to each unit vector in turn
+  matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getLHSDiagonal, this, invDiagonal, *solutionSet[fieldIndex]);
+
+  // Invert the diagonal. DOFs that don't get an entry (e.g. hanging nodes) aren't changed by the preconditioner.
+  for (unsigned int dof=0; dof<invDiagonal.local_size(); ++dof){
+      if (std::abs(invDiagonal.local_element(dof)) > 0.0){
+          invDiagonal.local_element(dof) = 1.0/invDiagonal.local_element(dof);
+      }
+      else {
+          invDiagonal.local_element(dof) = 1.0;
+      }
+  }
+
+  // The Dirichlet DOFs are copied from src to dst in vmult, so their diagonal entry is one
+  const std::vector<unsigned int> & dirichlet_dofs = localDirichletDoFSet[fieldIndex];
+  for (unsigned int k=0; k<dirichlet_dofs.size(); k++){
+      invDiagonal.local_element(dirichlet_dofs[k]) = 1.0;
+  }
+
+  if (invLHSDiagonalSingleSet[fieldIndex] != NULL){
+      parallel::distributed::Vector<float> & invDiagonalSingle = *invLHSDiagonalSingleSet[fieldIndex];
+      for (unsigned int dof=0; dof<invDiagonal.local_size(); ++dof){
+          invDiagonalSingle.local_element(dof) = (float)invDiagonal.local_element(dof);
+      }
+  }
+
+  //end log
+  computing_timer.exit_section("matrixFreePDE: computeLHSDiagonal");
+}
+
+template <int dim, int degree>
+void  MatrixFreePDE<dim,degree>::getLHSDiagonal(const MatrixFree<dim,double> &data,
+				 vectorType &dst,
+				 const vectorType &src,
+				 const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+    getLHSDiagonalForSolution(data,dst,solutionSet,cell_range);
+}
+
+template <int dim, int degree>
+void  MatrixFreePDE<dim,degree>::getLHSDiagonalForSolution(const MatrixFree<dim,double> &data,
+				 vectorType &dst,
+				 const std::vector<vectorType*> &solution_set,
+				 const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+    variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,userInputs.varInfoListLHS,&userInputs.varChangeInfoListLHS);
+
+	//loop over cells
+	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
+
+		// Initialize, read DOFs, and set evaulation flags for each variable
+        variable_list.reinit_and_eval(solution_set,cell);
+        variable_list.reinit_change_in_solution(cell,currentFieldIndex);
+
+        unsigned int num_dofs = variable_list.get_num_change_in_solution_dofs(currentFieldIndex);
+		unsigned int num_q_points = variable_list.get_num_q_points();
+
+        dealii::AlignedVector<dealii::VectorizedArray<double> > local_diagonal(num_dofs);
+
+        // Apply the LHS to each local unit vector and keep the matching entry
+        for (unsigned int i=0; i<num_dofs; ++i){
+            variable_list.eval_change_in_solution_unit_vector(i,currentFieldIndex);
+
+    		//loop over quadrature points
+    		for (unsigned int q=0; q<num_q_points; ++q){
+                variable_list.q_point = q;
+
+                dealii::Point<dim, dealii::VectorizedArray<double> > q_point_loc = variable_list.get_q_point_location();
+
+    			// Calculate the residuals
+                equationLHS(variable_list,q_point_loc);
+    		}
+
+            local_diagonal[i] = variable_list.integrate_change_in_solution_LHS_entry(i,currentFieldIndex);
+        }
+
+        // Distribute the diagonal entries from local to global
+        variable_list.distribute_change_in_solution_local_vector(local_diagonal,dst,currentFieldIndex);
+	}
+}
+
 #include "../../include/matrixFreePDE_template_instantiations.h"
@@ -16,9 +16,19 @@ void MatrixFreePDE<dim,degree>::computeExplicitRHS(){
       }
   }
 
+  // Set which local time stepping groups are advanced in this increment
+  updateTimeStepGroupFactors();
+
   //call to integrate and assemble
   matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getExplicitRHS, this, residualSet, solutionSet);
 
+  // Add the Neumann BC terms
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+      if (userInputs.var_eq_type[fieldIndex] == EXPLICIT_TIME_DEPENDENT){
+          applyNeumannBCs(fieldIndex);
+      }
+  }
+
   //end log
   computing_timer.exit_section("matrixFreePDE: computeRHS");
 }
@@ -29,11 +39,27 @@ void MatrixFreePDE<dim,degree>::getExplicitRHS(const MatrixFree<dim,double> &dat
                                         const std::vector<vectorType*> &src,
                                         const std::pair<unsigned int,unsigned int> &cell_range) const{
 
-    variableContainer<dim,degree,dealii::VectorizedArray<double> > variable_list(data,userInputs.varInfoListExplicitRHS);
+    // After the first substep, only the residuals of the subcycled fields that take the current substep are calculated
+    const std::vector<variable_info> & varInfoList = (currentExplicitSubstep == 0 ? userInputs.varInfoListExplicitRHS : userInputs.varInfoListExplicitRHSSubcycle[currentExplicitSubstep-1]);
+    variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,varInfoList);
 
     //loop over cells
     for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
 
+        // With local time stepping, the residual of a cell advanced by a multiple s of the time step is
+        // M*u + s*(R - M*u), where R is the residual from the user's equations (M*u plus the time step times the
+        // rate of change). The residual of a cell that isn't advanced in this increment is just M*u.
+        double step_factor = 1.0;
+        if (userInputs.local_time_step_groups > 1){
+            step_factor = timeStepGroupFactor[cellBatchTimeStepGroup[cell]];
+            if (step_factor != 1.0){
+                addExplicitMassTerms(data, dst, src, cell, 1.0-step_factor);
+            }
+            if (step_factor == 0.0){
+                continue;
+            }
+        }
+
         // Initialize, read DOFs, and set evaulation flags for each variable
         variable_list.reinit_and_eval(src, cell);
 
@@ -49,43 +75,107 @@ void MatrixFreePDE<dim,degree>::getExplicitRHS(const MatrixFree<dim,double> &dat
             explicitEquationRHS(variable_list,q_point_loc);
         }
 
-        variable_list.integrate_and_distribute(dst);
+        variable_list.integrate_and_distribute(dst, step_factor);
     }
 }
 
-//update RHS of each field
+//update RHS of the subcycled explicit fields that take a substep after the first one (the other fields hold their values)
 template <int dim, int degree>
-void MatrixFreePDE<dim,degree>::computeNonexplicitRHS(){
+void MatrixFreePDE<dim,degree>::computeSubcycledExplicitRHS(unsigned int substep){
   //log time
   computing_timer.enter_section("matrixFreePDE: computeRHS");
 
   //clear residual vectors before update
   for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
-      if (userInputs.var_eq_type[fieldIndex] != EXPLICIT_TIME_DEPENDENT){
+      if (userInputs.var_explicit_subcycling_steps[fieldIndex] > substep){
           (*residualSet[fieldIndex])=0.0;
       }
   }
 
   //call to integrate and assemble
-  matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getNonexplicitRHS, this, residualSet, solutionSet);
+  currentExplicitSubstep = substep; // Used in getExplicitRHS()
+  matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getExplicitRHS, this, residualSet, solutionSet);
+  currentExplicitSubstep = 0;
+
+  // Add the Neumann BC terms
+  for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+      if (userInputs.var_explicit_subcycling_steps[fieldIndex] > substep){
+          applyNeumannBCs(fieldIndex);
+      }
+  }
 
   //end log
   computing_timer.exit_section("matrixFreePDE: computeRHS");
 }
 
 template <int dim, int degree>
-void MatrixFreePDE<dim,degree>::getNonexplicitRHS(const MatrixFree<dim,double> &data,
+void MatrixFreePDE<dim,degree>::addExplicitMassTerms(const MatrixFree<dim,double> &data,
                                         std::vector<vectorType*> &dst,
                                         const std::vector<vectorType*> &src,
+                                        const unsigned int cell,
+                                        const double scale) const{
+
+    variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,userInputs.varInfoListExplicitMass);
+
+    variable_list.reinit_and_eval(src, cell);
+
+    const dealii::VectorizedArray<double> scale_vectorized = make_vectorized_array(scale);
+    unsigned int num_q_points = variable_list.get_num_q_points();
+
+    //loop over quadrature points
+    for (unsigned int q=0; q<num_q_points; ++q){
+        variable_list.q_point = q;
+
+        for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+            if (userInputs.var_eq_type[fieldIndex] == EXPLICIT_TIME_DEPENDENT){
+                if (userInputs.var_type[fieldIndex] == SCALAR){
+                    variable_list.set_scalar_value_term_RHS(fieldIndex, scale_vectorized*variable_list.get_scalar_value(fieldIndex));
+                }
+                else {
+                    variable_list.set_vector_value_term_RHS(fieldIndex, variable_list.get_vector_value(fieldIndex)*scale_vectorized);
+                }
+            }
+        }
+    }
+
+    variable_list.integrate_and_distribute(dst);
+}
+
+//update RHS of a single nonexplicit field, only evaluating the variables its equation depends on
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::computeNonexplicitRHS(unsigned int fieldIndex){
+  //log time
+  computing_timer.enter_section("matrixFreePDE: computeRHS");
+
+  currentFieldIndex = fieldIndex; // Used in getNonexplicitRHS() and in the user's nonExplicitEquationRHS()
+
+  //clear residual vector before update
+  (*residualSet[fieldIndex])=0.0;
+
+  //call to integrate and assemble
+  matrixFreeObject.cell_loop (&MatrixFreePDE<dim,degree>::getNonexplicitRHS, this, *residualSet[fieldIndex], solutionSet);
+
+  // Add the Neumann BC terms
+  applyNeumannBCs(fieldIndex);
+
+  //end log
+  computing_timer.exit_section("matrixFreePDE: computeRHS");
+}
+
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::getNonexplicitRHS(const MatrixFree<dim,double> &data,
+                                        vectorType &dst,
+                                        const std::vector<vectorType*> &src,
                                         const std::pair<unsigned int,unsigned int> &cell_range) const{
 
-    variableContainer<dim,degree,dealii::VectorizedArray<double> > variable_list(data,userInputs.varInfoListNonexplicitRHS);
+    variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,userInputs.varInfoListNonexplicitRHSByField[currentFieldIndex]);
 
     //loop over cells
     for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
 
         // Initialize, read DOFs, and set evaulation flags for each variable
         variable_list.reinit_and_eval(src, cell);
+        variable_list.reinit_and_eval_old_solution(oldSolutionSet, cell);
 
         unsigned int num_q_points = variable_list.get_num_q_points();
 
@@ -99,7 +189,7 @@ void MatrixFreePDE<dim,degree>::getNonexplicitRHS(const MatrixFree<dim,double> &
             nonExplicitEquationRHS(variable_list,q_point_loc);
         }
 
-        variable_list.integrate_and_distribute(dst);
+        variable_list.integrate_and_distribute(dst,currentFieldIndex);
     }
 }
 
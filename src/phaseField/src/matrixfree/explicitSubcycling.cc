@@ -0,0 +1,41 @@
+// updateSubcycledExplicitFields() method for the MatrixFreePDE class
+
+#include "../../include/matrixFreePDE.h"
+
+// Advance the explicit fields that take several substeps per time step. All of the subcycled fields take the same number
+// of substeps k (this is checked when the variable attributes are loaded), so they are at the same time at every substep.
+// They are updated k times, each time by 1/k of the update their RHS gives for the whole time step. This is called before
+// the other explicit fields are updated, so they hold their values from the start of the time step through all of the
+// substeps. The RHS of the first substep is the one already calculated for all of the explicit fields, and the RHS of
+// each substep after that is only calculated for the subcycled fields (the residuals of the other fields are left as they are).
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateSubcycledExplicitFields(){
+
+    const unsigned int steps = userInputs.max_explicit_subcycling_steps;
+
+    std::vector<unsigned int> subcycled_field_indices;
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        if (fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT && userInputs.var_explicit_subcycling_steps[fieldIndex] > 1){
+            subcycled_field_indices.push_back(fieldIndex);
+        }
+    }
+
+    for (unsigned int substep=0; substep<steps; substep++){
+
+        if (substep > 0){
+            // The RHS of the next substep uses the values of the fields from the last one (their ghost values are
+            // exchanged by the cell loop)
+            for (unsigned int i=0; i<subcycled_field_indices.size(); i++){
+                if (has_Dirichlet_BCs){
+                    constraintsDirichletSet[subcycled_field_indices[i]]->distribute(*solutionSet[subcycled_field_indices[i]]);
+                }
+                solutionSet[subcycled_field_indices[i]]->zero_out_ghosts();
+            }
+            computeSubcycledExplicitRHS(substep);
+        }
+
+        updateExplicitSolution(subcycled_field_indices, 1.0/steps);
+    }
+}
+
+#include "../../include/matrixFreePDE_template_instantiations.h"
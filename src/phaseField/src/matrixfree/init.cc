@@ -9,6 +9,12 @@ template <int dim, int degree>
  void MatrixFreePDE<dim,degree>::init(){
 	 computing_timer.enter_section("matrixFreePDE: initialization");
 
+	 // Set the maximum number of threads used by each MPI process
+	 if (userInputs.number_of_threads != numbers::invalid_unsigned_int){
+		 MultithreadInfo::set_thread_limit(userInputs.number_of_threads);
+	 }
+	 pcout << "number of threads per process: " << MultithreadInfo::n_threads() << std::endl;
+
 	 //creating mesh
 
 	 pcout << "creating problem mesh...\n";
@@ -41,6 +47,7 @@ template <int dim, int degree>
 	 // Setup system
 	 pcout << "initializing matrix free object\n";
 	 totalDOFs=0;
+	 unsigned int n_dof_indices=0;
 	 for(typename std::vector<Field<dim> >::iterator it = fields.begin(); it != fields.end(); ++it){
 		 currentFieldIndex=it->index;
 
@@ -78,8 +85,6 @@ template <int dim, int degree>
              isTimeDependentBVP=true;
              ellipticFieldIndex=it->index;
              hasNonExplicitEquation=true;
-             std::cerr << "PRISMS-PF Error: IMPLICIT_TIME_DEPENDENT equation types are not currently supported" << std::endl;
-             abort();
          }
          else if (it->pdetype==AUXILIARY){
              parabolicFieldIndex=it->index;
@@ -92,63 +97,90 @@ template <int dim, int degree>
              hasNonExplicitEquation=true;
 		 }
 
-		 //create FESystem
-		 FESystem<dim>* fe;
-
-		 if (it->type==SCALAR){
-			 fe=new FESystem<dim>(FE_Q<dim>(QGaussLobatto<1>(degree+1)),1);
-		 }
-		 else if (it->type==VECTOR){
-			 fe=new FESystem<dim>(FE_Q<dim>(QGaussLobatto<1>(degree+1)),dim);
+		 // Fields can share the FE object, DoF handler, locally relevant DoFs, and hanging node and periodicity constraints of an earlier field
+		 unsigned int shared_index = getSharedDoFFieldIndex(it->index);
+		 sharedDoFFieldIndexSet.push_back(shared_index);
+		 if (shared_index == it->index){
+			 dofIndexSet.push_back(n_dof_indices);
+			 n_dof_indices++;
 		 }
-		 else{
-			 pcout << "\nmatrixFreePDE.h: unknown field type\n";
-			 exit(-1);
+		 else {
+			 dofIndexSet.push_back(dofIndexSet.at(shared_index));
 		 }
-		 FESet.push_back(fe);
 
-		 //distribute DOFs
+		 FESystem<dim>* fe;
 		 DoFHandler<dim>* dof_handler;
+		 IndexSet* locally_relevant_dofs;
+		 ConstraintMatrix *constraintsDirichlet, *constraintsOther;
 
-		 dof_handler=new DoFHandler<dim>(triangulation);
-		 dofHandlersSet.push_back(dof_handler);
-		 dofHandlersSet_nonconst.push_back(dof_handler);
+		 if (shared_index == it->index){
+			 //create FESystem
+			 if (it->type==SCALAR){
+				 fe=new FESystem<dim>(FE_Q<dim>(QGaussLobatto<1>(degree+1)),1);
+			 }
+			 else if (it->type==VECTOR){
+				 fe=new FESystem<dim>(FE_Q<dim>(QGaussLobatto<1>(degree+1)),dim);
+			 }
+			 else{
+				 pcout << "\nmatrixFreePDE.h: unknown field type\n";
+				 exit(-1);
+			 }
 
-		 dof_handler->distribute_dofs (*fe);
-		 totalDOFs+=dof_handler->n_dofs();
+			 //distribute DOFs
+			 dof_handler=new DoFHandler<dim>(triangulation);
+			 dof_handler->distribute_dofs (*fe);
 
-		 // Extract locally_relevant_dofs
-		 IndexSet* locally_relevant_dofs;
+			 // The level DOFs are needed by the multigrid preconditioner (for every field, since the LHS may depend on any of them)
+			 #if (DEAL_II_VERSION_MAJOR >= 9)
+			 if (userInputs.use_multigrid){
+				 dof_handler->distribute_mg_dofs();
+			 }
+			 #endif
 
-		 locally_relevant_dofs=new IndexSet;
-		 locally_relevant_dofsSet.push_back(locally_relevant_dofs);
-		 locally_relevant_dofsSet_nonconst.push_back(locally_relevant_dofs);
+			 // Extract locally_relevant_dofs
+			 locally_relevant_dofs=new IndexSet;
+			 locally_relevant_dofs->clear();
+			 DoFTools::extract_locally_relevant_dofs (*dof_handler, *locally_relevant_dofs);
 
-		 locally_relevant_dofs->clear();
-		 DoFTools::extract_locally_relevant_dofs (*dof_handler, *locally_relevant_dofs);
+			 constraintsOther=new ConstraintMatrix;
+			 constraintsOther->clear(); constraintsOther->reinit(*locally_relevant_dofs);
 
-		 // Create constraints
-		 ConstraintMatrix *constraintsDirichlet, *constraintsOther;
+			 // Get hanging node constraints
+			 DoFTools::make_hanging_node_constraints (*dof_handler, *constraintsOther);
 
-		 constraintsDirichlet=new ConstraintMatrix; constraintsDirichletSet.push_back(constraintsDirichlet);
-		 constraintsDirichletSet_nonconst.push_back(constraintsDirichlet);
-		 constraintsOther=new ConstraintMatrix; constraintsOtherSet.push_back(constraintsOther);
-		 constraintsOtherSet_nonconst.push_back(constraintsOther);
-		 valuesDirichletSet.push_back(new std::map<dealii::types::global_dof_index, double>);
+			 // Add a constraint to fix the value at the origin to zero if all BCs are zero-derivative or periodic
+			 std::vector<int> rigidBodyModeComponents;
+			 //getComponentsWithRigidBodyModes(rigidBodyModeComponents);
+			 //setRigidBodyModeConstraints(rigidBodyModeComponents,constraintsOther,dof_handler);
 
-		 constraintsDirichlet->clear(); constraintsDirichlet->reinit(*locally_relevant_dofs);
-		 constraintsOther->clear(); constraintsOther->reinit(*locally_relevant_dofs);
+			 // Get constraints for periodic BCs
+			 setPeriodicityConstraints(constraintsOther,dof_handler);
 
-		 // Get hanging node constraints
-		 DoFTools::make_hanging_node_constraints (*dof_handler, *constraintsOther);
+			 constraintsOther->close();
+		 }
+		 else {
+			 fe=FESet.at(shared_index);
+			 dof_handler=dofHandlersSet_nonconst.at(shared_index);
+			 locally_relevant_dofs=locally_relevant_dofsSet_nonconst.at(shared_index);
+			 constraintsOther=constraintsOtherSet_nonconst.at(shared_index);
+		 }
 
-		 // Add a constraint to fix the value at the origin to zero if all BCs are zero-derivative or periodic
-		 std::vector<int> rigidBodyModeComponents;
-		 //getComponentsWithRigidBodyModes(rigidBodyModeComponents);
-		 //setRigidBodyModeConstraints(rigidBodyModeComponents,constraintsOther,dof_handler);
+		 FESet.push_back(fe);
+		 dofHandlersSet.push_back(dof_handler);
+		 dofHandlersSet_nonconst.push_back(dof_handler);
+		 locally_relevant_dofsSet.push_back(locally_relevant_dofs);
+		 locally_relevant_dofsSet_nonconst.push_back(locally_relevant_dofs);
+		 constraintsOtherSet.push_back(constraintsOther);
+		 constraintsOtherSet_nonconst.push_back(constraintsOther);
+		 totalDOFs+=dof_handler->n_dofs();
 
-		 // Get constraints for periodic BCs
-		 setPeriodicityConstraints(constraintsOther,dof_handler);
+		 // Create the Dirichlet constraints (these depend on the BCs of each field, so they are never shared)
+		 constraintsDirichlet=new ConstraintMatrix; constraintsDirichletSet.push_back(constraintsDirichlet);
+		 constraintsDirichletSet_nonconst.push_back(constraintsDirichlet);
+		 localDirichletDoFSet.push_back(std::vector<unsigned int>());
+		 nonUniformDirichletDoFSet.push_back(std::vector<nonUniformDirichletDoF>());
+
+		 constraintsDirichlet->clear(); constraintsDirichlet->reinit(*locally_relevant_dofs);
 
          // Check if Dirichlet BCs are used
          has_Dirichlet_BCs = false;
@@ -165,18 +197,25 @@ template <int dim, int degree>
 		 applyDirichletBCs();
 
 		 constraintsDirichlet->close();
-		 constraintsOther->close();
-
-		 // Store Dirichlet BC DOF's
-		 valuesDirichletSet[it->index]->clear();
-		 for (types::global_dof_index i=0; i<dof_handler->n_dofs(); i++){
-			 if (locally_relevant_dofs->is_element(i)){
-				 if (constraintsDirichlet->is_constrained(i)){
-					 (*valuesDirichletSet[it->index])[i] = constraintsDirichlet->get_inhomogeneity(i);
+
+		 // Store the local indices of the locally owned Dirichlet DOFs so that the vector entries
+		 // at the Dirichlet DOFs can be set without searching the constraints or converting global indices
+		 localDirichletDoFSet[it->index].clear();
+		 const IndexSet & locally_owned_dofs = dof_handler->locally_owned_dofs();
+		 for (unsigned int k=0; k<locally_relevant_dofs->n_elements(); k++){
+			 types::global_dof_index i = locally_relevant_dofs->nth_index_in_set(k);
+			 if (constraintsDirichlet->is_constrained(i)){
+				 if (locally_owned_dofs.is_element(i)){
+					 localDirichletDoFSet[it->index].push_back(locally_owned_dofs.index_within_set(i));
 				 }
 			 }
 		 }
 
+		 // Cache the non-uniform Dirichlet DOFs if their values are updated every time step
+		 if (userInputs.time_dependent_nonuniform_BCs){
+			 setNonUniformDirichletDoFs(it->index);
+		 }
+
 		 sprintf(buffer, "field '%2s' DOF : %u (Constraint DOF : %u)\n", \
 				 it->name.c_str(), dof_handler->n_dofs(), constraintsDirichlet->n_constraints());
 		 pcout << buffer;
@@ -189,12 +228,24 @@ template <int dim, int degree>
      #if (DEAL_II_VERSION_MAJOR < 9 && DEAL_II_VERSION_MINOR < 5)
          additional_data.mpi_communicator = MPI_COMM_WORLD;
      #endif
-	 additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
-     //additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::none;
+	 // Only partition the cells between threads when more than one thread is available
+	 if (MultithreadInfo::n_threads() > 1){
+	     additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+	 }
+	 else {
+	     additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::none;
+	 }
 	 additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
+	 setCellVectorizationCategories(additional_data);
 	 QGaussLobatto<1> quadrature (degree+1);
+	 std::vector<const DoFHandler<dim>*> matrix_free_dof_handlers;
+	 std::vector<const ConstraintMatrix*> matrix_free_constraints;
+	 getMatrixFreeDoFHandlers(matrix_free_dof_handlers, matrix_free_constraints);
 	 matrixFreeObject.clear();
-	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadrature, additional_data);
+	 matrixFreeObject.reinit (matrix_free_dof_handlers, matrix_free_constraints, quadrature, additional_data);
+
+	 // Sort the cell batches into the local time stepping groups
+	 setLocalTimeStepGroups();
 
 	 bool dU_scalar_init = false;
 	 bool dU_vector_init = false;
@@ -206,21 +257,116 @@ template <int dim, int degree>
 
 		 U=new vectorType; R=new vectorType;
 		 solutionSet.push_back(U); residualSet.push_back(R);
-		 matrixFreeObject.initialize_dof_vector(*R,  fieldIndex); *R=0;
+		 matrixFreeObject.initialize_dof_vector(*R,  dofIndexSet[fieldIndex]); *R=0;
 
-		 matrixFreeObject.initialize_dof_vector(*U,  fieldIndex); *U=0;
+		 matrixFreeObject.initialize_dof_vector(*U,  dofIndexSet[fieldIndex]); *U=0;
 
-		 // Initializing temporary dU vector required for implicit solves of the elliptic equation.
+		 // With adaptive time stepping, the rate of change of each explicit field is kept for the error estimate
+		 vectorType *rate = NULL;
+		 if (userInputs.adaptive_time_stepping && fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT){
+			 rate=new vectorType;
+			 matrixFreeObject.initialize_dof_vector(*rate,  dofIndexSet[fieldIndex]); *rate=0;
+		 }
+		 explicitRateSet.push_back(rate);
+
+		 // The explicit fields also keep their solution from the start of the time step in case the step is rejected
+		 vectorType *step_start = NULL;
+		 if (userInputs.adaptive_time_stepping && fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT){
+			 step_start=new vectorType;
+			 matrixFreeObject.initialize_dof_vector(*step_start,  dofIndexSet[fieldIndex]); *step_start=0;
+		 }
+		 explicitStepStartSet.push_back(step_start);
+
+		 // Implicit time-dependent fields keep their solution from the start of the time step for the "old()" dependencies
+		 vectorType *U_old = NULL;
+		 if (fields[fieldIndex].pdetype==IMPLICIT_TIME_DEPENDENT){
+			 U_old=new vectorType;
+			 matrixFreeObject.initialize_dof_vector(*U_old,  dofIndexSet[fieldIndex]); *U_old=0;
+		 }
+		 oldSolutionSet.push_back(U_old);
+
+		 // The preconditioner vectors are allocated on the first linear solve that needs them
+		 invLHSDiagonalSet.push_back(NULL);
+		 invLHSDiagonalSingleSet.push_back(NULL);
+		 LHSMaxEigenvalueSet.push_back(1.0);
+		 preconditionerSet.push_back(NULL);
+		 preconditionerSingleSet.push_back(NULL);
+		 preconditionerIncrementSet.push_back(-1);
+		 preconditionerDtSet.push_back(0.0);
+		 multigridSet.push_back(NULL);
+
+		 // The stored changes in the solution for the initial guesses of the linear solves (extrapolation needs one more vector for the solution at the start of the time step)
+		 unsigned int n_change_history_vectors = 0;
+		 if (fields[fieldIndex].pdetype==TIME_INDEPENDENT || fields[fieldIndex].pdetype==IMPLICIT_TIME_DEPENDENT){
+			 LinearSolverInitialGuessType initial_guess_type = userInputs.linear_solver_parameters.getInitialGuessType(fieldIndex);
+			 if (initial_guess_type == PREVIOUS_CHANGE){
+				 n_change_history_vectors = 1;
+			 }
+			 else if (initial_guess_type == LINEAR_EXTRAPOLATION){
+				 n_change_history_vectors = 2;
+			 }
+			 else if (initial_guess_type == QUADRATIC_EXTRAPOLATION){
+				 n_change_history_vectors = 3;
+			 }
+		 }
+		 std::vector<vectorType*> change_history;
+		 for (unsigned int i=0; i<n_change_history_vectors; i++){
+			 vectorType *change=new vectorType;
+			 matrixFreeObject.initialize_dof_vector(*change,  dofIndexSet[fieldIndex]); *change=0;
+			 change_history.push_back(change);
+		 }
+		 solutionChangeHistorySet.push_back(change_history);
+		 solutionChangeDtHistorySet.push_back(std::vector<double>(n_change_history_vectors,userInputs.dtValue));
+		 solutionChangeHistorySize.push_back(0);
+
+		 // Copies of the fields a time-independent field depends on, to measure how much they change between its solves
+		 std::vector<vectorType*> dependency_snapshots;
+		 if (fields[fieldIndex].pdetype==TIME_INDEPENDENT && userInputs.linear_solver_parameters.getSolveChangeThreshold(fieldIndex) > 0.0){
+			 for (unsigned int i=0; i<userInputs.var_dependencies_nonexplicit[fieldIndex].size(); i++){
+				 vectorType *snapshot=new vectorType;
+				 matrixFreeObject.initialize_dof_vector(*snapshot,  dofIndexSet[userInputs.var_dependencies_nonexplicit[fieldIndex][i]]); *snapshot=0;
+				 dependency_snapshots.push_back(snapshot);
+			 }
+		 }
+		 dependencySnapshotSet.push_back(dependency_snapshots);
+		 lastSolveIncrementSet.push_back(-1);
+
+		 // The state of the Newton-Krylov solver between its steps
+		 newtonInitialResidualSet.push_back(0.0);
+		 newtonResidualSet.push_back(0.0);
+		 newtonForcingTermSet.push_back(0.0);
+
+		 // The history for the Anderson acceleration of the fixed-point iterations of nonlinear auxiliary fields
+		 std::vector<vectorType*> anderson_history;
+		 if (fields[fieldIndex].pdetype==AUXILIARY && userInputs.var_nonlinear[fieldIndex] && userInputs.nonlinear_solver_parameters.getAndersonDepth(fieldIndex) > 0){
+			 for (unsigned int i=0; i<2*userInputs.nonlinear_solver_parameters.getAndersonDepth(fieldIndex)+2; i++){
+				 vectorType *history=new vectorType;
+				 matrixFreeObject.initialize_dof_vector(*history,  dofIndexSet[fieldIndex]); *history=0;
+				 anderson_history.push_back(history);
+			 }
+		 }
+		 andersonHistorySet.push_back(anderson_history);
+		 andersonIterateCount.push_back(0);
+
+		 // Initializing temporary dU vector required for implicit solves of the elliptic equation, and the scratch vectors with the same layout.
 		 if (fields[fieldIndex].pdetype==TIME_INDEPENDENT || fields[fieldIndex].pdetype==IMPLICIT_TIME_DEPENDENT || (fields[fieldIndex].pdetype==AUXILIARY && userInputs.var_nonlinear[fieldIndex])){
 			 if (fields[fieldIndex].type == SCALAR){
 				 if (dU_scalar_init == false){
-					 matrixFreeObject.initialize_dof_vector(dU_scalar,  fieldIndex);
+					 matrixFreeObject.initialize_dof_vector(dU_scalar,  dofIndexSet[fieldIndex]);
+					 scratchVectorsScalar.resize(2);
+					 for (unsigned int i=0; i<scratchVectorsScalar.size(); i++){
+						 matrixFreeObject.initialize_dof_vector(scratchVectorsScalar[i],  dofIndexSet[fieldIndex]);
+					 }
 					 dU_scalar_init = true;
 				 }
 			 }
 			 else {
 				 if (dU_vector_init == false){
-					 matrixFreeObject.initialize_dof_vector(dU_vector,  fieldIndex);
+					 matrixFreeObject.initialize_dof_vector(dU_vector,  dofIndexSet[fieldIndex]);
+					 scratchVectorsVector.resize(2);
+					 for (unsigned int i=0; i<scratchVectorsVector.size(); i++){
+						 matrixFreeObject.initialize_dof_vector(scratchVectorsVector[i],  dofIndexSet[fieldIndex]);
+					 }
 					 dU_vector_init = true;
 				 }
 			 }
@@ -232,6 +378,13 @@ template <int dim, int degree>
 		 computeInvM();
 	 }
 
+	 // Assemble the Neumann BC terms on the initial mesh
+	 localNeumannDoFSet.resize(fields.size());
+	 neumannTermSet.resize(fields.size());
+	 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		 setNeumannBCs(fieldIndex);
+	 }
+
 	 // Apply the initial conditions to the solution vectors
 	 // The initial conditions are re-applied below in the "adaptiveRefine" function so that the mesh can
 	 // adapt based on the initial conditions.
@@ -286,4 +439,70 @@ template <int dim, int degree>
 
  }
 
+// Find the first earlier field that has the same type (and so the same FE space) and the same periodic BCs as a field. The
+// fields then have the same DOFs and hanging node and periodicity constraints. Fields whose LHS needs a constraint to pin a
+// rigid body mode get their own constraints. Returns the field itself if DoF handlers aren't shared or no field matches.
+template <int dim, int degree>
+unsigned int MatrixFreePDE<dim,degree>::getSharedDoFFieldIndex(unsigned int fieldIndex){
+
+	if (!userInputs.share_dof_handlers){
+		return fieldIndex;
+	}
+
+	// The index of the first entry of each field in the BC list (with one entry for each component)
+	std::vector<unsigned int> starting_BC_list_index(fieldIndex+1,0);
+	for (unsigned int i=0; i<fieldIndex; i++){
+		starting_BC_list_index[i+1] = starting_BC_list_index[i] + (userInputs.var_type[i] == SCALAR ? 1 : dim);
+	}
+
+	unsigned int field_index_temp = currentFieldIndex;
+	std::vector<int> rigidBodyModeComponents;
+	currentFieldIndex = fieldIndex;
+	getComponentsWithRigidBodyModes(rigidBodyModeComponents);
+	currentFieldIndex = field_index_temp;
+	if (rigidBodyModeComponents.size() > 0){
+		return fieldIndex;
+	}
+
+	for (unsigned int i=0; i<fieldIndex; i++){
+		if (sharedDoFFieldIndexSet.at(i) != i || userInputs.var_type[i] != userInputs.var_type[fieldIndex]){
+			continue;
+		}
+
+		currentFieldIndex = i;
+		getComponentsWithRigidBodyModes(rigidBodyModeComponents);
+		currentFieldIndex = field_index_temp;
+		if (rigidBodyModeComponents.size() > 0){
+			continue;
+		}
+
+		bool same_periodicity = true;
+		for (unsigned int direction=0; direction<dim; direction++){
+			if ((userInputs.BC_list[starting_BC_list_index[i]].var_BC_type[2*direction] == PERIODIC) != (userInputs.BC_list[starting_BC_list_index[fieldIndex]].var_BC_type[2*direction] == PERIODIC)){
+				same_periodicity = false;
+			}
+		}
+		if (same_periodicity){
+			return i;
+		}
+	}
+
+	return fieldIndex;
+}
+
+// Collect the DoF handlers and hanging node and periodicity constraints for matrixFreeObject. Each field that owns its DoF handler adds
+// one entry, so the fields that share a DoF handler are distributed and indexed only once (entry dofIndexSet[fieldIndex] for each field).
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::getMatrixFreeDoFHandlers(std::vector<const DoFHandler<dim>*> &dof_handlers, std::vector<const ConstraintMatrix*> &constraints) const{
+
+	dof_handlers.clear();
+	constraints.clear();
+	for (unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+		if (sharedDoFFieldIndexSet.at(fieldIndex) == fieldIndex){
+			dof_handlers.push_back(dofHandlersSet.at(fieldIndex));
+			constraints.push_back(constraintsOtherSet.at(fieldIndex));
+		}
+	}
+}
+
 #include "../../include/matrixFreePDE_template_instantiations.h"
@@ -38,6 +38,8 @@ template <int dim, int degree>
    dofHandlersSet.push_back(dof_handler);
    dofHandlersSet_nonconst.push_back(dof_handler);
    dof_handler->distribute_dofs (*fe);
+   sharedDoFFieldIndexSet.push_back(0);
+   dofIndexSet.push_back(0);
 
    //extract locally_relevant_dofs
    IndexSet* locally_relevant_dofs;
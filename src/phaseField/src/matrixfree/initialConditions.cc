@@ -63,7 +63,7 @@ void MatrixFreePDE<dim,degree>::applyInitialConditions(){
             }
         }
 
-        matrixFreeObject.initialize_dof_vector (grain_index_field, scalar_field_index);
+        matrixFreeObject.initialize_dof_vector (grain_index_field, dofIndexSet[scalar_field_index]);
 
         // Declare the PField types and containers
         typedef PRISMS::PField<double*, double, dim> ScalarField;
@@ -161,10 +161,9 @@ void MatrixFreePDE<dim,degree>::applyInitialConditions(){
                     for (unsigned int cycle=0; cycle<userInputs.num_grain_smoothing_cycles; cycle++){
                         computeLaplaceRHS(fieldIndex);
 
-                        unsigned int invM_size = invM.local_size();
                         for (unsigned int dof=0; dof<solutionSet[fieldIndex]->local_size(); ++dof){
                             solutionSet[fieldIndex]->local_element(dof)=solutionSet[fieldIndex]->local_element(dof)-
-                            invM.local_element(dof%invM_size)*residualSet[fieldIndex]->local_element(dof)*dt_for_smoothing;
+                            invMscalar.local_element(dof)*residualSet[fieldIndex]->local_element(dof)*dt_for_smoothing;
                         }
 
                         solutionSet[fieldIndex]->update_ghost_values();
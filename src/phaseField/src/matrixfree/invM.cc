@@ -2,34 +2,30 @@
 
 #include "../../include/matrixFreePDE.h"
 
-//compute inverse of the diagonal mass matrix and store in vector invM
+//compute inverse of the diagonal mass matrix and store it in invMscalar (for the scalar fields) and invMvector (for the vector fields)
 template <int dim, int degree>
 void MatrixFreePDE<dim,degree>::computeInvM(){
-	//initialize  invM
-	bool invMInitialized=false;
-	unsigned int parabolicFieldIndex=0;
+	// All fields of the same type share the same DoF numbering, so one field of each type is enough
+	bool scalar_field_found=false, vector_field_found=false;
+	unsigned int scalar_field_index=0, vector_field_index=0;
 	for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
-		if (fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT || fields[fieldIndex].pdetype==AUXILIARY){
-			matrixFreeObject.initialize_dof_vector (invM, fieldIndex);
-			parabolicFieldIndex=fieldIndex;
-			invMInitialized=true;
-			break;
+		if (fields[fieldIndex].type==SCALAR && !scalar_field_found){
+			scalar_field_index=fieldIndex;
+			scalar_field_found=true;
+		}
+		else if (fields[fieldIndex].type==VECTOR && !vector_field_found){
+			vector_field_index=fieldIndex;
+			vector_field_found=true;
 		}
-	}
-	//check if invM initialized
-	if (!invMInitialized){
-		pcout << "matrixFreePDE.h: no PARABOLIC field... hence setting parabolicFieldIndex to 0 and marching ahead withn invM computation\n";
-		//exit(-1);
 	}
 
-	//compute invM
-	matrixFreeObject.initialize_dof_vector (invM, parabolicFieldIndex);
-	invM=0.0;
-
 	//select gauss lobatto quadrature points which are suboptimal but give diagonal M
-	if (fields[parabolicFieldIndex].type==SCALAR){
+	if (scalar_field_found){
+		matrixFreeObject.initialize_dof_vector (invMscalar, dofIndexSet[scalar_field_index]);
+		invMscalar=0.0;
+
 		VectorizedArray<double> one = make_vectorized_array (1.0);
-		FEEvaluation<dim,degree> fe_eval(matrixFreeObject, parabolicFieldIndex);
+		FEEvaluation<dim,degree> fe_eval(matrixFreeObject, dofIndexSet[scalar_field_index]);
 		const unsigned int n_q_points = fe_eval.n_q_points;
 		for (unsigned int cell=0; cell<matrixFreeObject.n_macro_cells(); ++cell){
 			fe_eval.reinit(cell);
@@ -37,17 +33,21 @@ void MatrixFreePDE<dim,degree>::computeInvM(){
 				fe_eval.submit_value(one,q);
 			}
 			fe_eval.integrate (true,false);
-			fe_eval.distribute_local_to_global (invM);
+			fe_eval.distribute_local_to_global (invMscalar);
 		}
+		invMscalar.compress(VectorOperation::add);
 	}
-	else {
+
+	if (vector_field_found){
+		matrixFreeObject.initialize_dof_vector (invMvector, dofIndexSet[vector_field_index]);
+		invMvector=0.0;
+
 		dealii::Tensor<1, dim, dealii::VectorizedArray<double> > oneV;
 		for (unsigned int i=0;i<dim;i++){
 			oneV[i] = 1.0;
 		}
 
-		FEEvaluation<dim,degree,degree+1,dim> fe_eval(matrixFreeObject, parabolicFieldIndex);
-
+		FEEvaluation<dim,degree,degree+1,dim> fe_eval(matrixFreeObject, dofIndexSet[vector_field_index]);
 		const unsigned int n_q_points = fe_eval.n_q_points;
 		for (unsigned int cell=0; cell<matrixFreeObject.n_macro_cells(); ++cell){
 			fe_eval.reinit(cell);
@@ -55,22 +55,132 @@ void MatrixFreePDE<dim,degree>::computeInvM(){
 				fe_eval.submit_value(oneV,q);
 			}
 			fe_eval.integrate (true,false);
-			fe_eval.distribute_local_to_global (invM);
+			fe_eval.distribute_local_to_global (invMvector);
 		}
+		invMvector.compress(VectorOperation::add);
 	}
 
-
-	invM.compress(VectorOperation::add);
 	//invert mass matrix diagonal elements
-	for (unsigned int k=0; k<invM.local_size(); ++k){
-		if (std::abs(invM.local_element(k))>1.0e-15){
-			invM.local_element(k) = 1./invM.local_element(k);
+	for (unsigned int k=0; k<invMscalar.local_size(); ++k){
+		if (std::abs(invMscalar.local_element(k))>1.0e-15){
+			invMscalar.local_element(k) = 1./invMscalar.local_element(k);
 		}
 		else{
-			invM.local_element(k) = 0;
+			invMscalar.local_element(k) = 0;
+		}
+	}
+	for (unsigned int k=0; k<invMvector.local_size(); ++k){
+		if (std::abs(invMvector.local_element(k))>1.0e-15){
+			invMvector.local_element(k) = 1./invMvector.local_element(k);
+		}
+		else{
+			invMvector.local_element(k) = 0;
+		}
+	}
+
+	if (scalar_field_found){
+		pcout << "computed mass matrix for the scalar fields (using FE space for field: " << scalar_field_index << ")\n";
+	}
+	if (vector_field_found){
+		pcout << "computed mass matrix for the vector fields (using FE space for field: " << vector_field_index << ")\n";
+	}
+}
+
+//update the given fields by multiplying their residuals by the inverse of the mass matrix
+//for a substep (fraction < 1), the solution is moved that fraction of the way to the update for the full time step
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateExplicitSolution(const std::vector<unsigned int> & fieldIndices, const double fraction){
+
+	// With adaptive time stepping, the largest change in the rate of change of the explicit fields is tracked in the same
+	// sweep, and the solution at the start of the time step is kept in case the time step is rejected (the stored rates
+	// are only updated once the time step is accepted)
+	bool track_rates = false;
+	double local_max_rate_change = 0.0;
+	const double inv_dt = 1.0/(fraction*userInputs.dtValue);
+
+	// The scalar and vector fields are updated in separate sweeps since each type has its own invM
+	for (unsigned int type_index=0; type_index<2; type_index++){
+		fieldType type = (type_index == 0 ? SCALAR : VECTOR);
+		const vectorType & invM = (type == SCALAR ? invMscalar : invMvector);
+
+		std::vector<double*> solution_ptrs;
+		std::vector<const double*> residual_ptrs;
+		std::vector<const double*> rate_ptrs;
+		std::vector<double*> step_start_ptrs;
+		std::vector<const std::vector<unsigned int>*> dirichlet_dof_lists;
+		for (unsigned int i=0; i<fieldIndices.size(); i++){
+			if (fields[fieldIndices[i]].type == type){
+				solution_ptrs.push_back(solutionSet[fieldIndices[i]]->begin());
+				residual_ptrs.push_back(residualSet[fieldIndices[i]]->begin());
+				if (fieldIndices[i] < explicitRateSet.size() && explicitRateSet[fieldIndices[i]] != NULL && fields[fieldIndices[i]].pdetype == EXPLICIT_TIME_DEPENDENT){
+					rate_ptrs.push_back(explicitRateSet[fieldIndices[i]]->begin());
+					step_start_ptrs.push_back(explicitStepStartSet[fieldIndices[i]]->begin());
+					track_rates = true;
+				}
+				else {
+					rate_ptrs.push_back(NULL);
+					step_start_ptrs.push_back(NULL);
+				}
+				dirichlet_dof_lists.push_back(&localDirichletDoFSet[fieldIndices[i]]);
+			}
+		}
+		if (solution_ptrs.size() == 0){
+			continue;
 		}
+
+		// Sweep through the DoFs in blocks small enough that the block of invM stays in cache while every
+		// field is updated, with a unit-stride innermost loop that the compiler can vectorize
+		const double * invM_ptr = invM.begin();
+		const unsigned int local_size = invM.local_size();
+		const unsigned int block_size = 1024;
+		std::vector<unsigned int> next_dirichlet_dof(solution_ptrs.size(), 0);
+		for (unsigned int block_start=0; block_start<local_size; block_start+=block_size){
+			const unsigned int block_end = std::min(block_start+block_size,local_size);
+			for (unsigned int f=0; f<solution_ptrs.size(); f++){
+				double * solution = solution_ptrs[f];
+				const double * residual = residual_ptrs[f];
+				const double * rate = rate_ptrs[f];
+				if (rate == NULL && fraction == 1.0){
+					for (unsigned int dof=block_start; dof<block_end; ++dof){
+						solution[dof] = invM_ptr[dof]*residual[dof];
+					}
+				}
+				else if (rate == NULL){
+					for (unsigned int dof=block_start; dof<block_end; ++dof){
+						solution[dof] += fraction*(invM_ptr[dof]*residual[dof]-solution[dof]);
+					}
+				}
+				else {
+					// The constrained DoFs are reset by the constraints after the update, so their values here aren't
+					// tracked: invM is zero at the hanging node DoFs, and the (sorted) local Dirichlet DoFs are
+					// stepped through alongside the sweep
+					double * step_start = step_start_ptrs[f];
+					const std::vector<unsigned int> & dirichlet_dofs = *dirichlet_dof_lists[f];
+					unsigned int & next_dirichlet = next_dirichlet_dof[f];
+					for (unsigned int dof=block_start; dof<block_end; ++dof){
+						const double new_solution = solution[dof] + fraction*(invM_ptr[dof]*residual[dof]-solution[dof]);
+						step_start[dof] = solution[dof];
+						if (next_dirichlet < dirichlet_dofs.size() && dirichlet_dofs[next_dirichlet] == dof){
+							next_dirichlet++;
+							solution[dof] = new_solution;
+							continue;
+						}
+						if (invM_ptr[dof] == 0.0){
+							solution[dof] = new_solution;
+							continue;
+						}
+						const double new_rate = (new_solution-solution[dof])*inv_dt;
+						local_max_rate_change = std::max(local_max_rate_change,std::abs(new_rate-rate[dof]));
+						solution[dof] = new_solution;
+					}
+				}
+			}
+		}
+	}
+
+	if (track_rates){
+		max_rate_change = Utilities::MPI::max(local_max_rate_change, MPI_COMM_WORLD);
 	}
-	pcout << "computed mass matrix (using FE space for field: " << parabolicFieldIndex << ")\n";
 }
 
 #include "../../include/matrixFreePDE_template_instantiations.h"
@@ -0,0 +1,92 @@
+// Methods for local time stepping of the explicit fields for the MatrixFreePDE class
+//
+// The cell batches are sorted into groups by refinement level. The batches with the finest cells are advanced by the
+// time step every increment, and the batches in group g are advanced by 2^g time steps every 2^g increments. Each
+// batch adds the whole rate of change of its cells over its own step, so the terms that only move a conserved
+// quantity between the DOFs of a cell still add up to zero and the conserved fields stay conserved.
+//
+// A coarse group takes its whole step at the start of its window of increments, so it runs up to 2^(n-1)-1 increments
+// ahead of the finest group (for n groups). All of the cells are only at the same time after the increments k where k+1
+// is a multiple of 2^(n-1). Remeshing, output and checkpoints are restricted to those increments by the input checks.
+// The nonexplicit fields are solved every increment from the explicit fields as they are, so in between those increments
+// they see a lagged state that mixes the times of the groups.
+
+#include "../../include/matrixFreePDE.h"
+
+// Sort the cell batches into the local time stepping groups. A batch can hold cells from several levels (unless the
+// cells are sorted into batches by level), so it is placed by its finest cell.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setLocalTimeStepGroups(){
+
+    cellBatchTimeStepGroup.assign(matrixFreeObject.n_macro_cells(), 0);
+    timeStepGroupFactor.assign(userInputs.local_time_step_groups, 1.0);
+
+    if (userInputs.local_time_step_groups == 1){
+        return;
+    }
+
+    const unsigned int finest_level = triangulation.n_global_levels()-1;
+
+    std::vector<unsigned int> group_cell_count(userInputs.local_time_step_groups, 0);
+    for (unsigned int cell=0; cell<matrixFreeObject.n_macro_cells(); ++cell){
+        unsigned int batch_level = 0;
+        for (unsigned int v=0; v<matrixFreeObject.n_components_filled(cell); ++v){
+            batch_level = std::max(batch_level, (unsigned int)matrixFreeObject.get_cell_iterator(cell,v)->level());
+        }
+        cellBatchTimeStepGroup[cell] = std::min(userInputs.local_time_step_groups-1, finest_level-batch_level);
+        group_cell_count[cellBatchTimeStepGroup[cell]] += matrixFreeObject.n_components_filled(cell);
+    }
+
+    std::vector<unsigned int> global_group_cell_count(userInputs.local_time_step_groups, 0);
+    Utilities::MPI::sum(group_cell_count, MPI_COMM_WORLD, global_group_cell_count);
+    pcout << "local time stepping groups (number of cells):";
+    for (unsigned int group=0; group<userInputs.local_time_step_groups; group++){
+        pcout << " " << global_group_cell_count[group];
+    }
+    pcout << "\n";
+}
+
+// Set the multiple of the time step that each group is advanced by in the current increment. Group g is advanced at
+// the increments that are multiples of 2^g, so the steps of all of the groups end together before every 2^(n-1)th
+// increment (where the mesh can change). In the first increment, each group takes a shorter step up to its first
+// regular step.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateTimeStepGroupFactors(){
+
+    if (userInputs.local_time_step_groups == 1){
+        return;
+    }
+
+    for (unsigned int group=0; group<userInputs.local_time_step_groups; group++){
+        const unsigned int group_steps = (1 << group);
+        const unsigned int position_in_step = currentIncrement%group_steps;
+
+        if (position_in_step == 0){
+            timeStepGroupFactor[group] = group_steps;
+        }
+        else if (currentIncrement == 1){
+            timeStepGroupFactor[group] = group_steps - position_in_step;
+        }
+        else {
+            timeStepGroupFactor[group] = 0.0;
+        }
+    }
+}
+
+// Set the vectorization category of each active cell to its level (only supported in deal.II version 9.0 and later)
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setCellVectorizationCategories(typename MatrixFree<dim,double>::AdditionalData & additional_data) const {
+
+    #if (DEAL_II_VERSION_MAJOR >= 9)
+    if (userInputs.local_time_step_groups > 1){
+        additional_data.cell_vectorization_category.assign(triangulation.n_active_cells(), 0);
+
+        typename Triangulation<dim>::active_cell_iterator cell = triangulation.begin_active(), endc = triangulation.end();
+        for (; cell!=endc; ++cell){
+            additional_data.cell_vectorization_category[cell->active_cell_index()] = cell->level();
+        }
+    }
+    #endif
+}
+
+#include "../../include/matrixFreePDE_template_instantiations.h"
@@ -10,8 +10,16 @@ template <int dim, int degree>
  Subscriptor(),
  pcout (std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0),
  userInputs(_userInputs),
+ // The multigrid preconditioner needs the level hierarchy of the mesh, which p4est only keeps with these settings
+ #if (DEAL_II_VERSION_MAJOR >= 9)
+ triangulation (MPI_COMM_WORLD,
+     _userInputs.use_multigrid ? Triangulation<dim>::limit_level_difference_at_vertices : Triangulation<dim>::none,
+     _userInputs.use_multigrid ? parallel::distributed::Triangulation<dim>::construct_multigrid_hierarchy : parallel::distributed::Triangulation<dim>::default_setting),
+ #else
  triangulation (MPI_COMM_WORLD),
+ #endif
  currentFieldIndex(0),
+ currentExplicitSubstep(0),
  isTimeDependentBVP(false),
  isEllipticBVP(false),
  hasExplicitEquation(false),
@@ -24,7 +32,13 @@ template <int dim, int degree>
  currentCheckpoint(0),
  current_grain_reassignment(0),
  computing_timer (pcout, TimerOutput::summary, TimerOutput::wall_times),
- first_integrated_var_output_complete(false)
+ first_integrated_var_output_complete(false),
+ explicit_rates_set(false),
+ max_rate_change(0.0),
+ nominal_dtValue(_userInputs.dtValue),
+ previous_dtValue(_userInputs.dtValue),
+ stable_dtValue(_userInputs.stable_dtValue),
+ stable_dt_min_cell_diameter(-1.0)
  {
  }
 
@@ -32,13 +46,20 @@ template <int dim, int degree>
  template <int dim, int degree>
  MatrixFreePDE<dim,degree>::~MatrixFreePDE ()
  {
+   // The cached variable containers refer to the MatrixFree objects, so they are deleted first
+   clearVariableContainerCache();
    matrixFreeObject.clear();
 
+   // The multigrid hierarchies refer to the DOF handlers, so they are deleted first
+   clearMultigrid();
+
    // Delete the pointers contained in several member variable vectors
    // The size of each of these must be checked individually in case an exception is thrown
-   // as they are being initialized.
+   // as they are being initialized. The objects shared between fields are only deleted once.
    for(unsigned int iter=0; iter<locally_relevant_dofsSet.size(); iter++){
-       delete locally_relevant_dofsSet[iter];
+       if (iter >= sharedDoFFieldIndexSet.size() || sharedDoFFieldIndexSet[iter] == iter){
+           delete locally_relevant_dofsSet[iter];
+       }
    }
    for(unsigned int iter=0; iter<constraintsDirichletSet.size(); iter++){
        delete constraintsDirichletSet[iter];
@@ -47,10 +68,14 @@ template <int dim, int degree>
        delete soltransSet[iter];
    }
    for(unsigned int iter=0; iter<dofHandlersSet.size(); iter++){
-       delete dofHandlersSet[iter];
+       if (iter >= sharedDoFFieldIndexSet.size() || sharedDoFFieldIndexSet[iter] == iter){
+           delete dofHandlersSet[iter];
+       }
    }
    for(unsigned int iter=0; iter<FESet.size(); iter++){
-       delete FESet[iter];
+       if (iter >= sharedDoFFieldIndexSet.size() || sharedDoFFieldIndexSet[iter] == iter){
+           delete FESet[iter];
+       }
    }
    for(unsigned int iter=0; iter<solutionSet.size(); iter++){
        delete solutionSet[iter];
@@ -58,6 +83,45 @@ template <int dim, int degree>
    for(unsigned int iter=0; iter<residualSet.size(); iter++){
        delete residualSet[iter];
    }
+   for(unsigned int iter=0; iter<explicitRateSet.size(); iter++){
+       delete explicitRateSet[iter];
+   }
+   for(unsigned int iter=0; iter<explicitStepStartSet.size(); iter++){
+       delete explicitStepStartSet[iter];
+   }
+   for(unsigned int iter=0; iter<oldSolutionSet.size(); iter++){
+       delete oldSolutionSet[iter];
+   }
+   for(unsigned int iter=0; iter<invLHSDiagonalSet.size(); iter++){
+       delete invLHSDiagonalSet[iter];
+   }
+   for(unsigned int iter=0; iter<invLHSDiagonalSingleSet.size(); iter++){
+       delete invLHSDiagonalSingleSet[iter];
+   }
+   for(unsigned int iter=0; iter<preconditionerSet.size(); iter++){
+       delete preconditionerSet[iter];
+   }
+   for(unsigned int iter=0; iter<preconditionerSingleSet.size(); iter++){
+       delete preconditionerSingleSet[iter];
+   }
+   for(unsigned int iter=0; iter<solutionChangeHistorySet.size(); iter++){
+       for(unsigned int i=0; i<solutionChangeHistorySet[iter].size(); i++){
+           delete solutionChangeHistorySet[iter][i];
+       }
+   }
+   for(unsigned int iter=0; iter<dependencySnapshotSet.size(); iter++){
+       for(unsigned int i=0; i<dependencySnapshotSet[iter].size(); i++){
+           delete dependencySnapshotSet[iter][i];
+       }
+   }
+   for(unsigned int iter=0; iter<postProcessedSet.size(); iter++){
+       delete postProcessedSet[iter];
+   }
+   for(unsigned int iter=0; iter<andersonHistorySet.size(); iter++){
+       for(unsigned int i=0; i<andersonHistorySet[iter].size(); i++){
+           delete andersonHistorySet[iter][i];
+       }
+   }
 
  }
 
@@ -0,0 +1,290 @@
+//Methods for the geometric multigrid preconditioner for the MatrixFreePDE class
+
+#include "../../include/matrixFreePDE.h"
+#include "../../include/LinearSolverMultigrid.h"
+
+#if (DEAL_II_VERSION_MAJOR >= 9)
+#include <deal.II/multigrid/mg_tools.h>
+
+// =================================================================================
+// Methods for the level LHS operator
+// =================================================================================
+template <int dim, int degree>
+void LevelLHSOperator<dim,degree>::apply_add(VectorType &dst, const VectorType &src) const{
+    this->data->cell_loop(&LevelLHSOperator<dim,degree>::local_apply, this, dst, src);
+}
+
+template <int dim, int degree>
+void LevelLHSOperator<dim,degree>::local_apply(const dealii::MatrixFree<dim,double> &data,
+    VectorType &dst,
+    const VectorType &src,
+    const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+    pde->getLHSForSolution(data,dst,src,*level_solution_set,cell_range);
+}
+
+template <int dim, int degree>
+void LevelLHSOperator<dim,degree>::compute_diagonal(){
+
+    this->inverse_diagonal_entries.reset(new dealii::DiagonalMatrix<VectorType>());
+    VectorType & inverse_diagonal = this->inverse_diagonal_entries->get_vector();
+    this->data->initialize_dof_vector(inverse_diagonal, this->selected_rows[0]);
+
+    // The src vector isn't used, the change in the solution is set to each unit vector in turn
+    VectorType unused_src;
+    unused_src.reinit(inverse_diagonal);
+    this->data->cell_loop(&LevelLHSOperator<dim,degree>::local_compute_diagonal, this, inverse_diagonal, unused_src);
+
+    // The constrained (Dirichlet) DOFs are copied from src to dst by the base class, so their diagonal entry is one
+    this->set_constrained_entries_to_one(inverse_diagonal);
+
+    for (unsigned int dof=0; dof<inverse_diagonal.local_size(); ++dof){
+        if (std::abs(inverse_diagonal.local_element(dof)) > 0.0){
+            inverse_diagonal.local_element(dof) = 1.0/inverse_diagonal.local_element(dof);
+        }
+        else {
+            inverse_diagonal.local_element(dof) = 1.0;
+        }
+    }
+}
+
+template <int dim, int degree>
+void LevelLHSOperator<dim,degree>::local_compute_diagonal(const dealii::MatrixFree<dim,double> &data,
+    VectorType &dst,
+    const VectorType &,
+    const std::pair<unsigned int,unsigned int> &cell_range) const{
+
+    pde->getLHSDiagonalForSolution(data,dst,*level_solution_set,cell_range);
+}
+#endif
+
+// =================================================================================
+// Methods for the multigrid hierarchy of a field
+// =================================================================================
+
+// Set up the multigrid hierarchy for a field. The hierarchy is built on the levels of the p4est mesh, so it covers
+// adaptive meshes (with the hanging nodes handled on the refinement edges). The level operators are built from the
+// user's equationLHS, and all of the fields are distributed on the levels so that the LHS can depend on them.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setupMultigrid(unsigned int fieldIndex){
+#if (DEAL_II_VERSION_MAJOR >= 9)
+    //log time
+    computing_timer.enter_section("matrixFreePDE: setupMultigrid");
+
+    LinearSolverMultigrid<dim,degree> * multigrid = new LinearSolverMultigrid<dim,degree>;
+    multigridSet[fieldIndex] = multigrid;
+
+    const unsigned int n_levels = triangulation.n_global_levels();
+
+    // Only the solved field and the fields needed to evaluate the LHS are transferred to the levels
+    std::vector<bool> field_on_levels(fields.size(),false);
+    field_on_levels[fieldIndex] = true;
+    for (unsigned int i=0; i<userInputs.varInfoListLHS.size(); i++){
+        if (userInputs.varInfoListLHS[i].var_needed){
+            field_on_levels[i] = true;
+        }
+    }
+
+    // Get the level DOFs on the Dirichlet boundaries of the solved field (for every component with a Dirichlet BC)
+    unsigned int starting_BC_list_index = 0;
+    for (unsigned int i=0; i<fieldIndex; i++){
+        if (userInputs.var_type[i] == SCALAR){
+            starting_BC_list_index++;
+        }
+        else {
+            starting_BC_list_index+=dim;
+        }
+    }
+    unsigned int n_components = (userInputs.var_type[fieldIndex] == SCALAR) ? 1 : dim;
+
+    std::vector<IndexSet> level_dirichlet_dofs(n_levels);
+    for (unsigned int level=0; level<n_levels; level++){
+        level_dirichlet_dofs[level].set_size(dofHandlersSet[fieldIndex]->n_dofs(level));
+    }
+
+    for (unsigned int direction = 0; direction < 2*dim; direction++){
+        std::vector<bool> mask;
+        bool has_dirichlet_component = false;
+        for (unsigned int component=0; component < n_components; component++){
+            if (userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] == DIRICHLET
+                || userInputs.BC_list[starting_BC_list_index+component].var_BC_type[direction] == NON_UNIFORM_DIRICHLET){
+                mask.push_back(true);
+                has_dirichlet_component = true;
+            }
+            else {
+                mask.push_back(false);
+            }
+        }
+
+        if (has_dirichlet_component){
+            std::set<types::boundary_id> boundary_ids;
+            boundary_ids.insert(direction);
+            std::vector<IndexSet> boundary_dofs;
+            MGTools::make_boundary_list(*dofHandlersSet[fieldIndex], boundary_ids, boundary_dofs, ComponentMask(mask));
+            for (unsigned int level=0; level<n_levels; level++){
+                level_dirichlet_dofs[level].add_indices(boundary_dofs[level]);
+            }
+        }
+    }
+
+    // Set up the level constraints and the transfer between the levels for each field on the levels
+    multigrid->mg_constrained_dofs.resize(fields.size());
+    multigrid->transfers.resize(fields.size());
+    for (unsigned int i=0; i<fields.size(); i++){
+        if (field_on_levels[i]){
+            multigrid->mg_constrained_dofs[i].reset(new MGConstrainedDoFs);
+            multigrid->mg_constrained_dofs[i]->initialize(*dofHandlersSet[i]);
+            if (i == fieldIndex){
+                for (unsigned int level=0; level<n_levels; level++){
+                    multigrid->mg_constrained_dofs[i]->add_boundary_indices(*dofHandlersSet[i], level, level_dirichlet_dofs[level]);
+                }
+            }
+
+            multigrid->transfers[i].reset(new MGTransferMatrixFree<dim,double>);
+            multigrid->transfers[i]->initialize_constraints(*multigrid->mg_constrained_dofs[i]);
+            multigrid->transfers[i]->build(*dofHandlersSet[i]);
+        }
+    }
+
+    // Set up the MatrixFree object and the LHS operator on each level
+    multigrid->level_matrix_free.resize(0,n_levels-1);
+    multigrid->level_solutions.resize(fields.size());
+    multigrid->level_solution_set.resize(0,n_levels-1);
+    multigrid->level_operators.resize(0,n_levels-1);
+    multigrid->interface_operators.resize(0,n_levels-1);
+
+    for (unsigned int i=0; i<fields.size(); i++){
+        multigrid->level_solutions[i].resize(0,n_levels-1);
+    }
+
+    for (unsigned int level=0; level<n_levels; level++){
+
+        // Only the Dirichlet DOFs of the solved field are constrained on the levels. Periodic faces are treated as
+        // natural boundaries on the levels, the periodicity is enforced by the CG iterations on the active mesh.
+        std::vector<ConstraintMatrix> level_constraints(fields.size());
+        std::vector<const ConstraintMatrix*> level_constraints_pointers;
+        for (unsigned int i=0; i<fields.size(); i++){
+            IndexSet relevant_dofs;
+            DoFTools::extract_locally_relevant_level_dofs(*dofHandlersSet[i], level, relevant_dofs);
+            level_constraints[i].reinit(relevant_dofs);
+            if (i == fieldIndex){
+                level_constraints[i].add_lines(multigrid->mg_constrained_dofs[i]->get_boundary_indices(level));
+            }
+            level_constraints[i].close();
+            level_constraints_pointers.push_back(&level_constraints[i]);
+        }
+
+        typename MatrixFree<dim,double>::AdditionalData additional_data;
+        if (MultithreadInfo::n_threads() > 1){
+            additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+        }
+        else {
+            additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::none;
+        }
+        additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
+        additional_data.level_mg_handler = level;
+        QGaussLobatto<1> quadrature (degree+1);
+
+        multigrid->level_matrix_free[level].reset(new MatrixFree<dim,double>);
+        multigrid->level_matrix_free[level]->reinit(dofHandlersSet, level_constraints_pointers, quadrature, additional_data);
+
+        // The level solution vectors are filled in updateMultigrid()
+        multigrid->level_solution_set[level].assign(fields.size(),NULL);
+        for (unsigned int i=0; i<userInputs.varInfoListLHS.size(); i++){
+            if (userInputs.varInfoListLHS[i].var_needed){
+                multigrid->level_matrix_free[level]->initialize_dof_vector(multigrid->level_solutions[i][level], i);
+                multigrid->level_solution_set[level][i] = &multigrid->level_solutions[i][level];
+            }
+        }
+
+        multigrid->level_operators[level].initialize(multigrid->level_matrix_free[level], *multigrid->mg_constrained_dofs[fieldIndex], level, std::vector<unsigned int>(1,fieldIndex));
+        multigrid->level_operators[level].set_pde(this, &multigrid->level_solution_set[level]);
+        multigrid->interface_operators[level].initialize(multigrid->level_operators[level]);
+    }
+
+    // Build the V-cycle and the preconditioner once for the mesh. The smoothers and the coarse solver they refer to are
+    // (re)initialized in updateMultigrid().
+    multigrid->mg_matrix.reset(new mg::Matrix<vectorType>(multigrid->level_operators));
+    multigrid->mg_interface.reset(new mg::Matrix<vectorType>(multigrid->interface_operators));
+    multigrid->mg_cycle.reset(new Multigrid<vectorType>(*multigrid->mg_matrix, multigrid->coarse, *multigrid->transfers[fieldIndex], multigrid->smoother, multigrid->smoother));
+    multigrid->mg_cycle->set_edge_matrices(*multigrid->mg_interface, *multigrid->mg_interface);
+    multigrid->preconditioner.reset(new PreconditionMG<dim, vectorType, MGTransferMatrixFree<dim,double> >(*dofHandlersSet[fieldIndex], *multigrid->mg_cycle, *multigrid->transfers[fieldIndex]));
+
+    //end log
+    computing_timer.exit_section("matrixFreePDE: setupMultigrid");
+#else
+    std::cerr << "PRISMS-PF Error: The MULTIGRID preconditioner requires deal.II version 9.0 or later." << std::endl;
+    abort();
+#endif
+}
+
+// Transfer the solution to the levels (for LHS that depend on it) and recompute the level diagonals and smoothers
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateMultigrid(unsigned int fieldIndex){
+#if (DEAL_II_VERSION_MAJOR >= 9)
+    //log time
+    computing_timer.enter_section("matrixFreePDE: updateMultigrid");
+
+    currentFieldIndex = fieldIndex; // Used in equationLHS()
+
+    LinearSolverMultigrid<dim,degree> & multigrid = *multigridSet[fieldIndex];
+    const unsigned int n_levels = triangulation.n_global_levels();
+
+    for (unsigned int i=0; i<userInputs.varInfoListLHS.size(); i++){
+        if (userInputs.varInfoListLHS[i].var_needed){
+            multigrid.transfers[i]->interpolate_to_mg(*dofHandlersSet[i], multigrid.level_solutions[i], *solutionSet[i]);
+            for (unsigned int level=0; level<n_levels; level++){
+                multigrid.level_solutions[i][level].update_ghost_values();
+            }
+        }
+    }
+
+    // The Chebyshev smoother uses the input file parameters on the finer levels. On the coarsest level it is run
+    // until the residual is reduced by three orders of magnitude, so the coarse solve stays a fixed linear operator.
+    MGLevelObject<typename LinearSolverMultigrid<dim,degree>::SmootherType::AdditionalData> smoother_data(0,n_levels-1);
+    for (unsigned int level=0; level<n_levels; level++){
+        multigrid.level_operators[level].compute_diagonal();
+
+        if (level > 0){
+            smoother_data[level].degree = userInputs.linear_solver_parameters.getChebyshevDegree(fieldIndex);
+            smoother_data[level].smoothing_range = userInputs.linear_solver_parameters.getChebyshevSmoothingRange(fieldIndex);
+            smoother_data[level].eig_cg_n_iterations = 12;
+        }
+        else {
+            smoother_data[0].degree = numbers::invalid_unsigned_int;
+            smoother_data[0].smoothing_range = 1.0e-3;
+            smoother_data[0].eig_cg_n_iterations = multigrid.level_operators[0].m();
+        }
+        smoother_data[level].preconditioner = multigrid.level_operators[level].get_matrix_diagonal_inverse();
+    }
+    multigrid.smoother.initialize(multigrid.level_operators, smoother_data);
+    multigrid.coarse.initialize(multigrid.smoother);
+
+    //end log
+    computing_timer.exit_section("matrixFreePDE: updateMultigrid");
+#endif
+}
+
+// Solve for the change in the solution of a field with CG preconditioned by one multigrid V-cycle per iteration
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::solveLinearSystemMultigrid(unsigned int fieldIndex, SolverCG<vectorType> & solver, vectorType & dU){
+#if (DEAL_II_VERSION_MAJOR >= 9)
+    solver.solve(*this, dU, *residualSet[fieldIndex], *multigridSet[fieldIndex]->preconditioner);
+#endif
+}
+
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::clearMultigrid(){
+#if (DEAL_II_VERSION_MAJOR >= 9)
+    // The cached variable containers may refer to the level MatrixFree objects
+    clearVariableContainerCache();
+    for (unsigned int fieldIndex=0; fieldIndex<multigridSet.size(); fieldIndex++){
+        if (multigridSet[fieldIndex] != NULL){
+            delete multigridSet[fieldIndex];
+            multigridSet[fieldIndex] = NULL;
+        }
+    }
+#endif
+}
+
+#include "../../include/matrixFreePDE_template_instantiations.h"
@@ -29,15 +29,12 @@ void MatrixFreePDE<dim,degree>::outputResults() {
   // Test section for outputting postprocessed fields
   // Currently there are hacks in place, using the matrixFreeObject, invM, constraints, and DoFHandler as the primary variables
   if (userInputs.postProcessingRequired){
-	  std::vector<vectorType*> postProcessedSet;
-      computePostProcessedFields(postProcessedSet);
+      computePostProcessedFields();
 
-	  unsigned int invM_size = invM.local_size();
+	  // The post-processed fields use the FE space of the first field
+	  const vectorType & invM = (fields[0].type == SCALAR ? invMscalar : invMvector);
 	  for(unsigned int fieldIndex=0; fieldIndex<postProcessedSet.size(); fieldIndex++){
-		  for (unsigned int dof=0; dof<postProcessedSet[fieldIndex]->local_size(); ++dof){
-			  postProcessedSet[fieldIndex]->local_element(dof)=			\
-					  invM.local_element(dof%invM_size)*postProcessedSet[fieldIndex]->local_element(dof);
-		  }
+		  postProcessedSet[fieldIndex]->scale(invM);
 		  constraintsOtherSet[0]->distribute(*postProcessedSet[fieldIndex]);
 		  postProcessedSet[fieldIndex]->update_ghost_values();
 	  }
@@ -58,15 +55,18 @@ void MatrixFreePDE<dim,degree>::outputResults() {
               output_file << currentTime;
           }
 
-          for (unsigned int i=0; i<userInputs.pp_number_of_variables; i++){
-              if (userInputs.pp_calc_integral[i]){
-                  double integrated_field;
-                  computeIntegral(integrated_field,i,postProcessedSet);
-                  pcout << "Integrated value of " << userInputs.pp_var_name[userInputs.integrated_field_indices[i]] << ": " << integrated_field << std::endl;
-                  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
-                      output_file << "\t" << userInputs.pp_var_name[userInputs.integrated_field_indices[i]] << "\t" << integrated_field;
-                  }
-                  integrated_postprocessed_fields.at(userInputs.integrated_field_indices[i]) = integrated_field;
+          // All of the selected post-processed fields are integrated in one pass (they all share the first DoFHandler)
+          std::vector<vectorType*> integrated_set;
+          for (unsigned int i=0; i<userInputs.num_integrated_fields; i++){
+              integrated_set.push_back(postProcessedSet[userInputs.integrated_field_indices[i]]);
+          }
+          std::vector<unsigned int> dof_handler_indices(userInputs.num_integrated_fields,0);
+          computeIntegralsMF(integrated_postprocessed_fields,dof_handler_indices,integrated_set);
+
+          for (unsigned int i=0; i<userInputs.num_integrated_fields; i++){
+              pcout << "Integrated value of " << userInputs.pp_var_name[userInputs.integrated_field_indices[i]] << ": " << integrated_postprocessed_fields[i] << std::endl;
+              if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
+                  output_file << "\t" << userInputs.pp_var_name[userInputs.integrated_field_indices[i]] << "\t" << integrated_postprocessed_fields[i];
               }
           }
           if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
@@ -2,15 +2,22 @@
 #include "../../include/matrixFreePDE.h"
 
 template <int dim,int degree>
-void MatrixFreePDE<dim,degree>::computePostProcessedFields(std::vector<vectorType*> &postProcessedSet) {
-
+void MatrixFreePDE<dim,degree>::computePostProcessedFields() {
+
+	// Allocate the postProcessedSet the first time it is needed (reinit() resizes it when the mesh changes)
+	if (postProcessedSet.size() != userInputs.pp_number_of_variables){
+		for(unsigned int fieldIndex=0; fieldIndex<userInputs.pp_number_of_variables; fieldIndex++){
+			vectorType *U;
+			U=new vectorType;
+			postProcessedSet.push_back(U);
+			matrixFreeObject.initialize_dof_vector(*U,  0);
+		}
+	}
 
-	// Zero out the postProcessedSet
-	for(unsigned int fieldIndex=0; fieldIndex<userInputs.pp_number_of_variables; fieldIndex++){
-		vectorType *U;
-		U=new vectorType;
-		postProcessedSet.push_back(U);
-		matrixFreeObject.initialize_dof_vector(*U,  0); *U=0;
+	// Zero out the postProcessedSet (including the ghost values from the last time it was used)
+	for(unsigned int fieldIndex=0; fieldIndex<postProcessedSet.size(); fieldIndex++){
+		postProcessedSet[fieldIndex]->zero_out_ghosts();
+		*postProcessedSet[fieldIndex]=0;
 	}
 
 	integrated_postprocessed_fields.clear();
@@ -29,9 +36,9 @@ void MatrixFreePDE<dim,degree>::getPostProcessedFields(const dealii::MatrixFree<
 		const std::vector<vectorType*> &src,
 		const std::pair<unsigned int,unsigned int> &cell_range) {
 
-	//initialize FEEvaulation objects
-	variableContainer<dim,degree,dealii::VectorizedArray<double> > variable_list(data,userInputs.pp_baseVarInfoList);
-	variableContainer<dim,degree,dealii::VectorizedArray<double> > pp_variable_list(data,userInputs.pp_varInfoList,0);
+	//get the FEEvaulation objects
+	variableContainer<dim,degree,dealii::VectorizedArray<double> > & variable_list = getVariableContainer(data,userInputs.pp_baseVarInfoList);
+	variableContainer<dim,degree,dealii::VectorizedArray<double> > & pp_variable_list = getVariableContainer(data,userInputs.pp_varInfoList,NULL,true);
 
 	//loop over cells
 	for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell){
@@ -0,0 +1,121 @@
+//Methods to set up the Jacobi, Chebyshev, and multigrid preconditioners for the MatrixFreePDE class
+
+#include "../../include/matrixFreePDE.h"
+#include <deal.II/lac/solver_cg.h>
+
+// Estimate the largest eigenvalue of the Jacobi-preconditioned LHS from the Lanczos coefficients of a few CG iterations
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::estimateLHSMaxEigenvalue(unsigned int fieldIndex){
+
+    currentFieldIndex = fieldIndex; // Used in vmult()
+
+    vectorType & x = getScratchVector(fieldIndex, 0);
+    vectorType & b = getScratchVector(fieldIndex, 1);
+    x = 0.0;
+
+    // A right hand side with some oscillation so that the high frequency modes are present in the Krylov space
+    for (unsigned int dof=0; dof<b.local_size(); ++dof){
+        b.local_element(dof) = 1.0 + 0.1*(double)(dof%11);
+    }
+
+    double max_eigenvalue = 1.0;
+    MaxEigenvalueRecorder eigenvalue_recorder(max_eigenvalue);
+
+    SolverControl solver_control(12, 1.0e-10*b.l2_norm(), false, false);
+    SolverCG<vectorType> solver(solver_control);
+    solver.connect_eigenvalues_slot(eigenvalue_recorder);
+
+    // The solve isn't expected to converge, only the eigenvalue estimate is needed
+    try{
+        if (invLHSDiagonalSingleSet[fieldIndex] != NULL){
+            LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType,parallel::distributed::Vector<float> > jacobi_preconditioner(*this, *invLHSDiagonalSingleSet[fieldIndex], JACOBI, 1, 1.0, 2.0);
+            solver.solve(*this, x, b, jacobi_preconditioner);
+        }
+        else {
+            LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType> jacobi_preconditioner(*this, *invLHSDiagonalSet[fieldIndex], JACOBI, 1, 1.0, 2.0);
+            solver.solve(*this, x, b, jacobi_preconditioner);
+        }
+    }
+    catch (...) {}
+
+    LHSMaxEigenvalueSet[fieldIndex] = max_eigenvalue;
+    if (preconditionerSingleSet[fieldIndex] != NULL){
+        preconditionerSingleSet[fieldIndex]->set_max_eigenvalue(max_eigenvalue);
+    }
+    else {
+        preconditionerSet[fieldIndex]->set_max_eigenvalue(max_eigenvalue);
+    }
+}
+
+// Recompute the preconditioner for a field when it may be out of date. It is always out of date after the mesh
+// changes or the time step changes. If the LHS depends on the solution (not just on the change in the solution),
+// the coefficients may change every increment, so the preconditioner is recomputed once per increment.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updatePreconditioner(unsigned int fieldIndex){
+
+    LinearSolverPreconditionerType preconditioner_type = userInputs.linear_solver_parameters.getPreconditionerType(fieldIndex);
+
+    if (preconditioner_type == NO_PRECONDITIONER){
+        return;
+    }
+
+    if (preconditioner_type == MULTIGRID){
+        // The multigrid hierarchy is deleted whenever the mesh changes
+        if (multigridSet[fieldIndex] == NULL){
+            setupMultigrid(fieldIndex);
+            preconditionerIncrementSet[fieldIndex] = -1;
+        }
+    }
+    // The diagonal and the preconditioner object are allocated once and then kept for every solve of the field (the
+    // diagonal is resized in place when the mesh changes). The Chebyshev iterations use the first two scratch vectors,
+    // which aren't otherwise used during the linear solve.
+    else if (userInputs.linear_solver_parameters.getPreconditionerPrecision(fieldIndex) == SINGLE_PRECISION){
+        if (invLHSDiagonalSingleSet[fieldIndex] == NULL){
+            invLHSDiagonalSingleSet[fieldIndex] = new parallel::distributed::Vector<float>;
+            matrixFreeObject.initialize_dof_vector(*invLHSDiagonalSingleSet[fieldIndex], dofIndexSet[fieldIndex]);
+
+            preconditionerSingleSet[fieldIndex] = new LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType,parallel::distributed::Vector<float> >;
+            preconditionerSingleSet[fieldIndex]->initialize(*this, *invLHSDiagonalSingleSet[fieldIndex], preconditioner_type,
+                userInputs.linear_solver_parameters.getChebyshevDegree(fieldIndex), userInputs.linear_solver_parameters.getChebyshevSmoothingRange(fieldIndex));
+            preconditionerSingleSet[fieldIndex]->set_work_vectors(getScratchVector(fieldIndex, 0), getScratchVector(fieldIndex, 1));
+            preconditionerIncrementSet[fieldIndex] = -1;
+        }
+    }
+    else if (invLHSDiagonalSet[fieldIndex] == NULL){
+        invLHSDiagonalSet[fieldIndex] = new vectorType;
+        matrixFreeObject.initialize_dof_vector(*invLHSDiagonalSet[fieldIndex], dofIndexSet[fieldIndex]);
+
+        preconditionerSet[fieldIndex] = new LinearSolverPreconditioner<MatrixFreePDE<dim,degree>,vectorType>;
+        preconditionerSet[fieldIndex]->initialize(*this, *invLHSDiagonalSet[fieldIndex], preconditioner_type,
+            userInputs.linear_solver_parameters.getChebyshevDegree(fieldIndex), userInputs.linear_solver_parameters.getChebyshevSmoothingRange(fieldIndex));
+        preconditionerSet[fieldIndex]->set_work_vectors(getScratchVector(fieldIndex, 0), getScratchVector(fieldIndex, 1));
+        preconditionerIncrementSet[fieldIndex] = -1;
+    }
+
+    bool lhs_depends_on_solution = false;
+    for (unsigned int i=0; i<userInputs.varInfoListLHS.size(); i++){
+        if (userInputs.varInfoListLHS[i].var_needed){
+            lhs_depends_on_solution = true;
+        }
+    }
+
+    if (preconditionerIncrementSet[fieldIndex] < 0 || preconditionerDtSet[fieldIndex] != userInputs.dtValue
+        || (lhs_depends_on_solution && preconditionerIncrementSet[fieldIndex] != (int)currentIncrement)){
+
+        if (preconditioner_type == MULTIGRID){
+            updateMultigrid(fieldIndex);
+        }
+        else {
+            computeInvLHSDiagonal(fieldIndex);
+
+            if (preconditioner_type == CHEBYSHEV){
+                estimateLHSMaxEigenvalue(fieldIndex);
+            }
+        }
+
+        preconditionerIncrementSet[fieldIndex] = currentIncrement;
+        preconditionerDtSet[fieldIndex] = userInputs.dtValue;
+    }
+}
+
+#include "../../include/matrixFreePDE_template_instantiations.h"
@@ -14,6 +14,11 @@ void MatrixFreePDE<dim,degree>::reassignGrains () {
 
     pcout << "Reassigning grains..." << std::endl;
 
+    // The ghost values of the explicit fields aren't kept up to date between time steps
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        solutionSet[fieldIndex]->update_ghost_values();
+    }
+
     // Get the index of the first scalar field (used to get the FE object and DOFHandler)
     unsigned int scalar_field_index = 0;
     for (unsigned int var=0; var<userInputs.number_of_variables; var++){
@@ -8,6 +8,9 @@ template <int dim, int degree>
 
 	 computing_timer.enter_section("matrixFreePDE: reinitialization");
 
+	 // The multigrid hierarchies are rebuilt for the new mesh on the next linear solve that needs them
+	 clearMultigrid();
+
 	 //setup system
 	 pcout << "Reinitializing matrix free object\n";
 	 totalDOFs=0;
@@ -16,6 +19,9 @@ template <int dim, int degree>
 
 		 char buffer[100];
 
+		 // The DOFs and the hanging node and periodicity constraints of fields that share a DoF handler are only set up once
+		 bool owns_dofs = (sharedDoFFieldIndexSet.at(it->index) == it->index);
+
 		 //create FESystem
 		 FESystem<dim>* fe;
 		 fe=FESet.at(it->index);
@@ -24,15 +30,25 @@ template <int dim, int degree>
 		 DoFHandler<dim>* dof_handler;
 		 dof_handler=dofHandlersSet_nonconst.at(it->index);
 
-		 dof_handler->distribute_dofs (*fe);
+		 if (owns_dofs){
+			 dof_handler->distribute_dofs (*fe);
+
+			 #if (DEAL_II_VERSION_MAJOR >= 9)
+			 if (userInputs.use_multigrid){
+				 dof_handler->distribute_mg_dofs();
+			 }
+			 #endif
+		 }
 		 totalDOFs+=dof_handler->n_dofs();
 
 		 //extract locally_relevant_dofs
 		 IndexSet* locally_relevant_dofs;
 		 locally_relevant_dofs=locally_relevant_dofsSet_nonconst.at(it->index);
 
-		 locally_relevant_dofs->clear();
-		 DoFTools::extract_locally_relevant_dofs (*dof_handler, *locally_relevant_dofs);
+		 if (owns_dofs){
+			 locally_relevant_dofs->clear();
+			 DoFTools::extract_locally_relevant_dofs (*dof_handler, *locally_relevant_dofs);
+		 }
 
 		 //create constraints
 		 ConstraintMatrix *constraintsDirichlet, *constraintsOther;
@@ -41,35 +57,47 @@ template <int dim, int degree>
 		 constraintsOther=constraintsOtherSet_nonconst.at(it->index);
 
 		 constraintsDirichlet->clear(); constraintsDirichlet->reinit(*locally_relevant_dofs);
-		 constraintsOther->clear(); constraintsOther->reinit(*locally_relevant_dofs);
 
-		 // Get hanging node constraints
-		 DoFTools::make_hanging_node_constraints (*dof_handler, *constraintsOther);
+		 if (owns_dofs){
+			 constraintsOther->clear(); constraintsOther->reinit(*locally_relevant_dofs);
 
-		 // Add a constraint to fix the value at the origin to zero if all BCs are zero-derivative or periodic
-		 std::vector<int> rigidBodyModeComponents;
-		 getComponentsWithRigidBodyModes(rigidBodyModeComponents);
-		 setRigidBodyModeConstraints(rigidBodyModeComponents,constraintsOther,dof_handler);
+			 // Get hanging node constraints
+			 DoFTools::make_hanging_node_constraints (*dof_handler, *constraintsOther);
 
-		 // Get constraints for periodic BCs
-		 setPeriodicityConstraints(constraintsOther,dof_handler);
+			 // Add a constraint to fix the value at the origin to zero if all BCs are zero-derivative or periodic
+			 std::vector<int> rigidBodyModeComponents;
+			 getComponentsWithRigidBodyModes(rigidBodyModeComponents);
+			 setRigidBodyModeConstraints(rigidBodyModeComponents,constraintsOther,dof_handler);
+
+			 // Get constraints for periodic BCs
+			 setPeriodicityConstraints(constraintsOther,dof_handler);
+
+			 constraintsOther->close();
+		 }
 
 		 // Get constraints for Dirichlet BCs
 		 applyDirichletBCs();
 
 		 constraintsDirichlet->close();
-		 constraintsOther->close();
-
-		 // Store Dirichlet BC DOF's
-		 valuesDirichletSet[it->index]->clear();
-		 for (types::global_dof_index i=0; i<dof_handler->n_dofs(); i++){
-			 if (locally_relevant_dofs->is_element(i)){
-				 if (constraintsDirichlet->is_constrained(i)){
-					 (*valuesDirichletSet[it->index])[i] = constraintsDirichlet->get_inhomogeneity(i);
+
+		 // Store the local indices of the locally owned Dirichlet DOFs so that the vector entries
+		 // at the Dirichlet DOFs can be set without searching the constraints or converting global indices
+		 localDirichletDoFSet[it->index].clear();
+		 const IndexSet & locally_owned_dofs = dof_handler->locally_owned_dofs();
+		 for (unsigned int k=0; k<locally_relevant_dofs->n_elements(); k++){
+			 types::global_dof_index i = locally_relevant_dofs->nth_index_in_set(k);
+			 if (constraintsDirichlet->is_constrained(i)){
+				 if (locally_owned_dofs.is_element(i)){
+					 localDirichletDoFSet[it->index].push_back(locally_owned_dofs.index_within_set(i));
 				 }
 			 }
 		 }
 
+		 // Cache the non-uniform Dirichlet DOFs if their values are updated every time step
+		 if (userInputs.time_dependent_nonuniform_BCs){
+			 setNonUniformDirichletDoFs(it->index);
+		 }
+
 		 sprintf(buffer, "field '%2s' DOF : %u (Constraint DOF : %u)\n", \
 				 it->name.c_str(), dof_handler->n_dofs(), constraintsDirichlet->n_constraints());
 		 pcout << buffer;
@@ -82,13 +110,26 @@ template <int dim, int degree>
      #if (DEAL_II_VERSION_MAJOR < 9 && DEAL_II_VERSION_MINOR < 5)
          additional_data.mpi_communicator = MPI_COMM_WORLD;
      #endif
- 	 additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
-     //additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::none;
+ 	 // Only partition the cells between threads when more than one thread is available
+ 	 if (MultithreadInfo::n_threads() > 1){
+ 	     additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::partition_partition;
+ 	 }
+ 	 else {
+ 	     additional_data.tasks_parallel_scheme = MatrixFree<dim,double>::AdditionalData::none;
+ 	 }
      //additional_data.tasks_block_size = 1; // This improves performance for small runs, not sure about larger runs
  	 additional_data.mapping_update_flags = (update_values | update_gradients | update_JxW_values | update_quadrature_points);
+ 	 setCellVectorizationCategories(additional_data);
  	 QGaussLobatto<1> quadrature (degree+1);
+ 	 std::vector<const DoFHandler<dim>*> matrix_free_dof_handlers;
+ 	 std::vector<const ConstraintMatrix*> matrix_free_constraints;
+ 	 getMatrixFreeDoFHandlers(matrix_free_dof_handlers, matrix_free_constraints);
+ 	 clearVariableContainerCache();
  	 matrixFreeObject.clear();
- 	 matrixFreeObject.reinit (dofHandlersSet, constraintsOtherSet, quadrature, additional_data);
+ 	 matrixFreeObject.reinit (matrix_free_dof_handlers, matrix_free_constraints, quadrature, additional_data);
+
+ 	 // Sort the cell batches into the local time stepping groups
+ 	 setLocalTimeStepGroups();
 
  	bool dU_scalar_init = false;
  	bool dU_vector_init = false;
@@ -100,19 +141,66 @@ template <int dim, int degree>
 
  		 U=solutionSet.at(fieldIndex);
 
- 		 matrixFreeObject.initialize_dof_vector(*U,  fieldIndex); *U=0;
-
- 		// Initializing temporary dU vector required for implicit solves of the elliptic equation.
+ 		 matrixFreeObject.initialize_dof_vector(*U,  dofIndexSet[fieldIndex]); *U=0;
+
+ 		 // The rates of change from the old mesh can't be compared with the new ones, so the error estimate restarts
+ 		 if (explicitRateSet.at(fieldIndex) != NULL){
+ 			 matrixFreeObject.initialize_dof_vector(*explicitRateSet.at(fieldIndex),  dofIndexSet[fieldIndex]); *explicitRateSet.at(fieldIndex)=0;
+ 			 explicit_rates_set = false;
+ 		 }
+ 		 if (explicitStepStartSet.at(fieldIndex) != NULL){
+ 			 matrixFreeObject.initialize_dof_vector(*explicitStepStartSet.at(fieldIndex),  dofIndexSet[fieldIndex]);
+ 		 }
+
+ 		 // The old solutions are copied from the (transferred) solution at the start of the next time step
+ 		 if (oldSolutionSet.at(fieldIndex) != NULL){
+ 			 matrixFreeObject.initialize_dof_vector(*oldSolutionSet.at(fieldIndex),  dofIndexSet[fieldIndex]); *oldSolutionSet.at(fieldIndex)=0;
+ 		 }
+
+ 		 // The preconditioner has to be recomputed on the new mesh
+ 		 if (invLHSDiagonalSet.at(fieldIndex) != NULL){
+ 			 matrixFreeObject.initialize_dof_vector(*invLHSDiagonalSet.at(fieldIndex),  dofIndexSet[fieldIndex]);
+ 			 preconditionerIncrementSet.at(fieldIndex) = -1;
+ 		 }
+ 		 if (invLHSDiagonalSingleSet.at(fieldIndex) != NULL){
+ 			 matrixFreeObject.initialize_dof_vector(*invLHSDiagonalSingleSet.at(fieldIndex),  dofIndexSet[fieldIndex]);
+ 			 preconditionerIncrementSet.at(fieldIndex) = -1;
+ 		 }
+
+ 		 // The stored changes in the solution aren't transferred to the new mesh, so the initial guesses start over
+ 		 for (unsigned int i=0; i<solutionChangeHistorySet.at(fieldIndex).size(); i++){
+ 			 matrixFreeObject.initialize_dof_vector(*solutionChangeHistorySet.at(fieldIndex).at(i),  dofIndexSet[fieldIndex]); *solutionChangeHistorySet.at(fieldIndex).at(i)=0;
+ 		 }
+ 		 solutionChangeHistorySize.at(fieldIndex) = 0;
+
+ 		 // The time-independent fields are solved again on the new mesh before their solutions are reused
+ 		 for (unsigned int i=0; i<dependencySnapshotSet.at(fieldIndex).size(); i++){
+ 			 matrixFreeObject.initialize_dof_vector(*dependencySnapshotSet.at(fieldIndex).at(i),  dofIndexSet[userInputs.var_dependencies_nonexplicit[fieldIndex][i]]); *dependencySnapshotSet.at(fieldIndex).at(i)=0;
+ 		 }
+ 		 lastSolveIncrementSet.at(fieldIndex) = -1;
+
+ 		 // The Anderson history is only kept within a solve, so it isn't transferred to the new mesh
+ 		 for (unsigned int i=0; i<andersonHistorySet.at(fieldIndex).size(); i++){
+ 			 matrixFreeObject.initialize_dof_vector(*andersonHistorySet.at(fieldIndex).at(i),  dofIndexSet[fieldIndex]); *andersonHistorySet.at(fieldIndex).at(i)=0;
+ 		 }
+
+ 		// Initializing temporary dU vector required for implicit solves of the elliptic equation, and the scratch vectors with the same layout.
  		if (fields[fieldIndex].pdetype==TIME_INDEPENDENT || fields[fieldIndex].pdetype==IMPLICIT_TIME_DEPENDENT || (fields[fieldIndex].pdetype==AUXILIARY && userInputs.var_nonlinear[fieldIndex])){
  			if (fields[fieldIndex].type == SCALAR){
  				if (dU_scalar_init == false){
- 					matrixFreeObject.initialize_dof_vector(dU_scalar,  fieldIndex);
+ 					matrixFreeObject.initialize_dof_vector(dU_scalar,  dofIndexSet[fieldIndex]);
+ 					for (unsigned int i=0; i<scratchVectorsScalar.size(); i++){
+ 						matrixFreeObject.initialize_dof_vector(scratchVectorsScalar[i],  dofIndexSet[fieldIndex]);
+ 					}
  					dU_scalar_init = true;
  				}
  			}
  			else {
  				if (dU_vector_init == false){
- 					matrixFreeObject.initialize_dof_vector(dU_vector,  fieldIndex);
+ 					matrixFreeObject.initialize_dof_vector(dU_vector,  dofIndexSet[fieldIndex]);
+ 					for (unsigned int i=0; i<scratchVectorsVector.size(); i++){
+ 						matrixFreeObject.initialize_dof_vector(scratchVectorsVector[i],  dofIndexSet[fieldIndex]);
+ 					}
  					dU_vector_init = true;
  				}
  			}
@@ -124,6 +212,16 @@ template <int dim, int degree>
  		 computeInvM();
  	 }
 
+ 	 // The stability limit on an adaptive time step follows the smallest cell of the new mesh (once the time stepping has started)
+ 	 if (stable_dt_min_cell_diameter > 0.0){
+ 		 updateStableTimeStep();
+ 	 }
+
+ 	 // Assemble the Neumann BC terms on the new mesh
+ 	 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+ 		 setNeumannBCs(fieldIndex);
+ 	 }
+
  	 // Transfer solution from previous mesh
  	 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
 
@@ -133,7 +231,12 @@ template <int dim, int degree>
 
  		 //reset residual vector
  		 vectorType *R=residualSet.at(fieldIndex);
- 		 matrixFreeObject.initialize_dof_vector(*R,  fieldIndex); *R=0;
+ 		 matrixFreeObject.initialize_dof_vector(*R,  dofIndexSet[fieldIndex]); *R=0;
+ 	 }
+
+ 	 // Resize the post-processed fields (if they have been allocated), they are recomputed before they are used
+ 	 for(unsigned int fieldIndex=0; fieldIndex<postProcessedSet.size(); fieldIndex++){
+ 		 matrixFreeObject.initialize_dof_vector(*postProcessedSet[fieldIndex],  0);
  	 }
 
  	 // Create new solution transfer sets
@@ -18,11 +18,7 @@ void MatrixFreePDE<dim,degree>::setNonlinearEqInitialGuess(){
 
             computeLaplaceRHS(fieldIndex);
 
-            for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[fieldIndex]->begin(); it!=valuesDirichletSet[fieldIndex]->end(); ++it){
-                if (residualSet[fieldIndex]->in_local_range(it->first)){
-                    (*residualSet[fieldIndex])(it->first) = 0.0;
-                }
-            }
+            zeroDirichletDoFs(*residualSet[fieldIndex], fieldIndex);
 
             //solver controls
             double tol_value;
@@ -46,19 +46,39 @@ void MatrixFreePDE<dim,degree>::solve(){
         currentIncrement++;
 
         // Cycle up to the proper output and checkpoint counters
-        while (userInputs.outputTimeStepList.size() > 0 && userInputs.outputTimeStepList[currentOutput] < currentIncrement){
-            currentOutput++;
+        if (userInputs.adaptive_time_stepping){
+            while (currentOutput < userInputs.outputTimeList.size() && userInputs.outputTimeList[currentOutput] < currentTime){
+                currentOutput++;
+            }
+            while (currentCheckpoint < userInputs.checkpointTimeList.size() && userInputs.checkpointTimeList[currentCheckpoint] < currentTime){
+                currentCheckpoint++;
+            }
         }
-        while (userInputs.checkpointTimeStepList.size() > 0 && userInputs.checkpointTimeStepList[currentCheckpoint] < currentIncrement){
-            currentCheckpoint++;
+        else {
+            while (userInputs.outputTimeStepList.size() > 0 && userInputs.outputTimeStepList[currentOutput] < currentIncrement){
+                currentOutput++;
+            }
+            while (userInputs.checkpointTimeStepList.size() > 0 && userInputs.checkpointTimeStepList[currentCheckpoint] < currentIncrement){
+                currentCheckpoint++;
+            }
         }
 
+        // The declared stable time step is for the smallest cell of the mesh at the start of the time stepping
+        updateStableTimeStep();
+
         //time stepping
-        pcout << "\nTime stepping parameters: timeStep: " << userInputs.dtValue << "  timeFinal: " << userInputs.finalTime << "  timeIncrements: " << userInputs.totalIncrements << "\n";
+        if (userInputs.adaptive_time_stepping){
+            pcout << "\nTime stepping parameters (adaptive): initial timeStep: " << userInputs.dtValue << "  timeFinal: " << userInputs.finalTime << "  tolerance: " << userInputs.adaptive_time_step_tolerance << "\n";
+        }
+        else {
+            pcout << "\nTime stepping parameters: timeStep: " << userInputs.dtValue << "  timeFinal: " << userInputs.finalTime << "  timeIncrements: " << userInputs.totalIncrements << "\n";
+        }
 
         // This is the main time-stepping loop
-        for (; currentIncrement<=userInputs.totalIncrements; ++currentIncrement){
+        // With adaptive time stepping, the loop runs until the final time instead of for a set number of increments
+        for (; !timeSteppingComplete(); ++currentIncrement){
             //increment current time
+            setTimeStepForNextIncrement();
             currentTime+=userInputs.dtValue;
             if (currentIncrement%userInputs.skip_print_steps==0){
                 pcout << "\ntime increment:" << currentIncrement << "  time: " << currentTime << "\n";
@@ -67,6 +87,11 @@ void MatrixFreePDE<dim,degree>::solve(){
             //check and perform adaptive mesh refinement
             adaptiveRefine(currentIncrement);
 
+            // Update the values of the time-dependent non-uniform Dirichlet BCs for the new time
+            if (userInputs.time_dependent_nonuniform_BCs){
+                updateNonUniformDirichletBCs();
+            }
+
             // Update the list of nuclei (if relevant)
             updateNucleiList();
 
@@ -78,8 +103,14 @@ void MatrixFreePDE<dim,degree>::solve(){
             //solve time increment
             solveIncrement(false);
 
+            // With adaptive time stepping, the increment is solved again with a shorter time step while its error
+            // estimate is over the tolerance
+            while (rejectAdaptiveTimeStep()){
+                solveIncrement(false);
+            }
+
             // Output results to file (on the proper increments)
-            if (userInputs.outputTimeStepList[currentOutput] == currentIncrement) {
+            if (scheduledEventDue(userInputs.outputTimeStepList, userInputs.outputTimeList, currentOutput)) {
                 for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
                     constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
                     constraintsOtherSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
@@ -90,11 +121,14 @@ void MatrixFreePDE<dim,degree>::solve(){
             }
 
             // Create a checkpoint (on the proper increments)
-            if (userInputs.checkpointTimeStepList[currentCheckpoint] == currentIncrement) {
+            if (scheduledEventDue(userInputs.checkpointTimeStepList, userInputs.checkpointTimeList, currentCheckpoint)) {
                 save_checkpoint();
                 currentCheckpoint++;
             }
 
+            // Choose the time step for the next increment (if adaptive time stepping is enabled)
+            updateAdaptiveTimeStep();
+
         }
     }
 
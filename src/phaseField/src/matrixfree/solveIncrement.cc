@@ -2,6 +2,8 @@
 
 #include "../../include/matrixFreePDE.h"
 #include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/full_matrix.h>
+#include <algorithm>
 
 //solve each time increment
 template <int dim, int degree>
@@ -12,9 +14,26 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
     Timer time;
     char buffer[200];
 
-    // Get the RHS of the explicit equations
+    // Keep the solution of the implicit time-dependent fields from the start of the time step
+    if (!skip_time_dependent){
+        storeOldSolution();
+    }
+
+    // Get the RHS of the explicit equations and update all of the explicit fields in a single pass
     if (hasExplicitEquation && !skip_time_dependent){
         computeExplicitRHS();
+
+        // Advance the subcycled explicit fields through their substeps first, so the RHS of each substep sees the other
+        // explicit fields at the start of the time step (their residuals from the first RHS are kept until they're updated)
+        updateSubcycledExplicitFields();
+
+        std::vector<unsigned int> explicit_field_indices;
+        for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+            if (fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT && userInputs.var_explicit_subcycling_steps[fieldIndex] == 1){
+                explicit_field_indices.push_back(fieldIndex);
+            }
+        }
+        updateExplicitSolution(explicit_field_indices);
     }
 
 
@@ -22,27 +41,16 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
     for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
         currentFieldIndex = fieldIndex; // Used in computeLHS()
 
-        // Add Neumann BC terms to the residual vector for the current field, if appropriate
-        // Currently commented out because it isn't working yet
-        //applyNeumannBCs();
-
         //Parabolic (first order derivatives in time) fields
         if (fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT && !skip_time_dependent){
 
-            // Explicit-time step each DOF
-            // Takes advantage of knowledge that the length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
-            unsigned int invM_size = invM.local_size();
-            for (unsigned int dof=0; dof<solutionSet[fieldIndex]->local_size(); ++dof){
-                solutionSet[fieldIndex]->local_element(dof)=			\
-                invM.local_element(dof%invM_size)*residualSet[fieldIndex]->local_element(dof);
-            }
             // Set the Dirichelet values (hanging node constraints don't need to be distributed every time step, only at output)
             if (has_Dirichlet_BCs){
                 constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
             }
-            //computing_timer.enter_section("matrixFreePDE: updateExplicitGhosts");
-            solutionSet[fieldIndex]->update_ghost_values();
-            //computing_timer.exit_section("matrixFreePDE: updateExplicitGhosts");
+            // The ghost values are now out of date. They aren't exchanged here: the cell loop of the next explicit RHS
+            // starts the exchange itself and processes the interior cells while it completes.
+            solutionSet[fieldIndex]->zero_out_ghosts();
 
             // Print update to screen and confirm that solution isn't nan
             if (currentIncrement%userInputs.skip_print_steps==0){
@@ -66,26 +74,63 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
     }
 
-    // Now, update the non-explicit variables
-    // For the time being, this is just the elliptic equations, but implicit parabolic and auxilary equations should also be here
+    // Now, update the non-explicit variables (the implicit time-dependent, time-independent, and auxiliary equations)
     if (hasNonExplicitEquation){
 
-        bool nonlinear_it_converged = false;
+        // Keep the solution at the start of the time step for the extrapolated initial guesses of the linear solves
+        if (!skip_time_dependent){
+            storeSolutionForChangeHistory();
+        }
+
+        // Time-independent fields whose dependencies have barely changed since their last solve keep their last solution
+        std::vector<bool> reuse_solution(fields.size(),false);
+        bool nonexplicit_solve_needed = false;
+        for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+            if (fields[fieldIndex].pdetype == TIME_INDEPENDENT && !skip_time_dependent){
+                reuse_solution[fieldIndex] = reuseLastSolution(fieldIndex);
+            }
+            if (fields[fieldIndex].pdetype != EXPLICIT_TIME_DEPENDENT && !reuse_solution[fieldIndex]){
+                nonexplicit_solve_needed = true;
+            }
+        }
+
+        // The LHS cell loops read the solution of the other fields without exchanging their ghost values, so the
+        // explicit fields need theirs before the nonexplicit fields are solved
+        if (nonexplicit_solve_needed && hasExplicitEquation && !skip_time_dependent){
+            for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+                if (fields[fieldIndex].pdetype==EXPLICIT_TIME_DEPENDENT){
+                    solutionSet[fieldIndex]->update_ghost_values();
+                }
+            }
+        }
+
+        bool nonlinear_it_converged = !nonexplicit_solve_needed;
         unsigned int nonlinear_it_index = 0;
 
+        // The Anderson acceleration only mixes the iterates of the current solve
+        std::fill(andersonIterateCount.begin(), andersonIterateCount.end(), 0);
+
         while (!nonlinear_it_converged){
             nonlinear_it_converged = true; // Set to true here and will be set to false if any variable isn't converged
 
-            // Update residualSet for the non-explicitly updated variables
-            //compute_nonexplicit_RHS()
-            // Ideally, I'd just do this for the non-explicit variables, but for now I'll do all of them
-            // this is a little redundant, but hopefully not too terrible
-            computeNonexplicitRHS();
-
             for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
                 currentFieldIndex = fieldIndex; // Used in computeLHS()
 
-                if ( (fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || fields[fieldIndex].pdetype == TIME_INDEPENDENT){
+                if ( ((fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || fields[fieldIndex].pdetype == TIME_INDEPENDENT) && !reuse_solution[fieldIndex]
+                    && userInputs.var_nonlinear[fieldIndex] && userInputs.nonlinear_solver_parameters.getSolverType(fieldIndex) == NEWTON_KRYLOV){
+
+                    // Take one inexact Newton step for this field
+                    bool newton_converged = solveNewtonKrylovStep(fieldIndex, nonlinear_it_index, (nonlinear_it_index == 0 && !skip_time_dependent));
+
+                    if (!newton_converged && nonlinear_it_index < userInputs.nonlinear_solver_parameters.getMaxIterations()){
+                        nonlinear_it_converged = false;
+                    }
+                }
+                else if ( ((fields[fieldIndex].pdetype == IMPLICIT_TIME_DEPENDENT && !skip_time_dependent) || fields[fieldIndex].pdetype == TIME_INDEPENDENT) && !reuse_solution[fieldIndex]
+                    && (userInputs.var_nonlinear[fieldIndex] || nonlinear_it_index == 0)){
+
+                    // Update the residual of this field (the fields solved before it in this iteration are already updated)
+                    computeNonexplicitRHS(fieldIndex);
 
                     if (currentIncrement%userInputs.skip_print_steps==0 && userInputs.var_nonlinear[fieldIndex]){
                         sprintf(buffer, "field '%2s' [nonlinear solve]: current solution: %12.6e, current residual:%12.6e\n", \
@@ -95,16 +140,10 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         pcout<<buffer;
                     }
 
-                    dealii::parallel::distributed::Vector<double> solution_diff = *solutionSet[fieldIndex];
-
                     //apply Dirichlet BC's
                     // Loops through all DoF to which ones have Dirichlet BCs applied, replace the ones that do with the Dirichlet value
                     // This clears the residual where we want to apply Dirichlet BCs, otherwise the solver sees a positive residual
-                    for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[fieldIndex]->begin(); it!=valuesDirichletSet[fieldIndex]->end(); ++it){
-                        if (residualSet[fieldIndex]->in_local_range(it->first)){
-                            (*residualSet[fieldIndex])(it->first) = 0.0;
-                        }
-                    }
+                    zeroDirichletDoFs(*residualSet[fieldIndex], fieldIndex);
 
                     //solver controls
                     double tol_value;
@@ -117,23 +156,8 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
                     SolverControl solver_control(userInputs.linear_solver_parameters.getMaxIterations(fieldIndex), tol_value);
 
-                    // Currently the only allowed solver is SolverCG, the SolverType input variable is a dummy
-                    SolverCG<vectorType> solver(solver_control);
-
                     //solve
-                    try{
-                        if (fields[fieldIndex].type == SCALAR){
-                            dU_scalar=0.0;
-                            solver.solve(*this, dU_scalar, *residualSet[fieldIndex], IdentityMatrix(solutionSet[fieldIndex]->size()));
-                        }
-                        else {
-                            dU_vector=0.0;
-                            solver.solve(*this, dU_vector, *residualSet[fieldIndex], IdentityMatrix(solutionSet[fieldIndex]->size()));
-                        }
-                    }
-                    catch (...) {
-                        pcout << "\nWarning: implicit solver did not converge as per set tolerances. consider increasing maxSolverIterations or decreasing solverTolerance.\n";
-                    }
+                    solveLinearSystem(fieldIndex, solver_control, (nonlinear_it_index == 0 && !skip_time_dependent));
 
                     if (userInputs.var_nonlinear[fieldIndex]){
 
@@ -141,7 +165,6 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         double damping_coefficient;
 
                         if (userInputs.nonlinear_solver_parameters.getBacktrackDampingFlag(fieldIndex)){
-                            vectorType solutionSet_old = *solutionSet[fieldIndex];
                             double residual_old = residualSet[fieldIndex]->l2_norm();
 
                             damping_coefficient = 1.0;
@@ -154,13 +177,9 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                                     solutionSet[fieldIndex]->sadd(1.0,damping_coefficient,dU_vector);
                                 }
 
-                                computeNonexplicitRHS();
+                                computeNonexplicitRHS(fieldIndex);
 
-                                for (std::map<types::global_dof_index, double>::const_iterator it=valuesDirichletSet[fieldIndex]->begin(); it!=valuesDirichletSet[fieldIndex]->end(); ++it){
-                                    if (residualSet[fieldIndex]->in_local_range(it->first)){
-                                        (*residualSet[fieldIndex])(it->first) = 0.0;
-                                    }
-                                }
+                                zeroDirichletDoFs(*residualSet[fieldIndex], fieldIndex);
 
                                 double residual_new = residualSet[fieldIndex]->l2_norm();
 
@@ -173,8 +192,14 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                                     damping_coefficient_found = true;
                                 }
                                 else{
+                                    // Undo the rejected step in place instead of keeping a copy of the old solution
+                                    if (fields[fieldIndex].type == SCALAR){
+                                        solutionSet[fieldIndex]->add(-damping_coefficient,dU_scalar);
+                                    }
+                                    else {
+                                        solutionSet[fieldIndex]->add(-damping_coefficient,dU_vector);
+                                    }
                                     damping_coefficient *= userInputs.nonlinear_solver_parameters.getBacktrackStepModifier(fieldIndex);
-                                    *solutionSet[fieldIndex] = solutionSet_old;
                                 }
                             }
                         }
@@ -228,32 +253,28 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                         }
                     }
                     else {
-                        if (nonlinear_it_index ==0){
+                        if (fields[fieldIndex].type == SCALAR){
+                            *solutionSet[fieldIndex] += dU_scalar;
+                        }
+                        else {
+                            *solutionSet[fieldIndex] += dU_vector;
+                        }
 
+                        if (currentIncrement%userInputs.skip_print_steps==0){
+                            double dU_norm;
                             if (fields[fieldIndex].type == SCALAR){
-                                *solutionSet[fieldIndex] += dU_scalar;
+                                dU_norm = dU_scalar.l2_norm();
                             }
                             else {
-                                *solutionSet[fieldIndex] += dU_vector;
-                            }
-
-                            if (currentIncrement%userInputs.skip_print_steps==0){
-                                double dU_norm;
-                                if (fields[fieldIndex].type == SCALAR){
-                                    dU_norm = dU_scalar.l2_norm();
-                                }
-                                else {
-                                    dU_norm = dU_vector.l2_norm();
-                                }
-                                sprintf(buffer, "field '%2s' [implicit solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, tolerance criterion:%12.6e, solution: %12.6e, dU: %12.6e\n", \
-                                fields[fieldIndex].name.c_str(),			\
-                                residualSet[fieldIndex]->l2_norm(),			\
-                                solver_control.last_value(),				\
-                                solver_control.last_step(), solver_control.tolerance(), solutionSet[fieldIndex]->l2_norm(), dU_norm);
-                                pcout<<buffer;
+                                dU_norm = dU_vector.l2_norm();
                             }
+                            sprintf(buffer, "field '%2s' [implicit solve]: initial residual:%12.6e, current residual:%12.6e, nsteps:%u, tolerance criterion:%12.6e, solution: %12.6e, dU: %12.6e\n", \
+                            fields[fieldIndex].name.c_str(),			\
+                            residualSet[fieldIndex]->l2_norm(),			\
+                            solver_control.last_value(),				\
+                            solver_control.last_step(), solver_control.tolerance(), solutionSet[fieldIndex]->l2_norm(), dU_norm);
+                            pcout<<buffer;
                         }
-
                     }
                 }
                 else if (fields[fieldIndex].pdetype == AUXILIARY){
@@ -270,13 +291,9 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
                             }
                         }
 
-                        // Explicit-time step each DOF
-                        // Takes advantage of knowledge that the length of solutionSet and residualSet is an integer multiple of the length of invM for vector variables
-                        unsigned int invM_size = invM.local_size();
-                        for (unsigned int dof=0; dof<solutionSet[fieldIndex]->local_size(); ++dof){
-                            solutionSet[fieldIndex]->local_element(dof)=			\
-                            invM.local_element(dof%invM_size)*residualSet[fieldIndex]->local_element(dof);
-                        }
+                        // Update the residual of this field and explicit-time step each DOF
+                        computeNonexplicitRHS(fieldIndex);
+                        updateExplicitSolution(std::vector<unsigned int>(1,fieldIndex));
 
                         // Set the Dirichelet values (hanging node constraints don't need to be distributed every time step, only at output)
                         constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
@@ -311,6 +328,13 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
                                 if (diff > userInputs.nonlinear_solver_parameters.getToleranceValue(fieldIndex) && nonlinear_it_index < userInputs.nonlinear_solver_parameters.getMaxIterations()){
                                     nonlinear_it_converged = false;
+
+                                    // Mix the new iterate with the previous ones for the next iteration
+                                    if (andersonHistorySet[fieldIndex].size() > 0){
+                                        applyAndersonAcceleration(fieldIndex);
+                                        constraintsDirichletSet[fieldIndex]->distribute(*solutionSet[fieldIndex]);
+                                        solutionSet[fieldIndex]->update_ghost_values();
+                                    }
                                 }
 
                             }
@@ -333,6 +357,16 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
             nonlinear_it_index++;
         }
+
+        for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+            if (fields[fieldIndex].pdetype == TIME_INDEPENDENT && !reuse_solution[fieldIndex]){
+                storeLastSolve(fieldIndex);
+            }
+        }
+
+        if (!skip_time_dependent){
+            updateSolutionChangeHistory();
+        }
     }
 
     if (currentIncrement%userInputs.skip_print_steps==0){
@@ -343,4 +377,349 @@ void MatrixFreePDE<dim,degree>::solveIncrement(bool skip_time_dependent){
 
 }
 
+// Solve for the change in the solution of a non-explicit field, using the preconditioner and initial guess given in the input file
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::solveLinearSystem(unsigned int fieldIndex, SolverControl & solver_control, bool first_solve_of_time_step){
+
+    vectorType & dU = (fields[fieldIndex].type == SCALAR) ? dU_scalar : dU_vector;
+    dU=0.0;
+
+    // If the residual is already below the tolerance, the solve (and the preconditioner update) is skipped and the change in the solution is zero
+    double initial_residual = residualSet[fieldIndex]->l2_norm();
+    if (initial_residual <= solver_control.tolerance()){
+        solver_control.check(0, initial_residual);
+    }
+    else {
+        updatePreconditioner(fieldIndex);
+        currentFieldIndex = fieldIndex; // Used in vmult()
+
+        if (first_solve_of_time_step){
+            setLinearSolverInitialGuess(fieldIndex, dU);
+        }
+
+        // Currently the only allowed solver is SolverCG, the SolverType input variable is a dummy
+        SolverCG<vectorType> solver(solver_control);
+
+        try{
+            LinearSolverPreconditionerType preconditioner_type = userInputs.linear_solver_parameters.getPreconditionerType(fieldIndex);
+            if (preconditioner_type == NO_PRECONDITIONER){
+                solver.solve(*this, dU, *residualSet[fieldIndex], IdentityMatrix(solutionSet[fieldIndex]->size()));
+            }
+            else if (preconditioner_type == MULTIGRID){
+                solveLinearSystemMultigrid(fieldIndex, solver, dU);
+            }
+            else if (preconditionerSingleSet[fieldIndex] != NULL){
+                solver.solve(*this, dU, *residualSet[fieldIndex], *preconditionerSingleSet[fieldIndex]);
+            }
+            else {
+                solver.solve(*this, dU, *residualSet[fieldIndex], *preconditionerSet[fieldIndex]);
+            }
+        }
+        catch (...) {
+            pcout << "\nWarning: implicit solver did not converge as per set tolerances. consider increasing maxSolverIterations or decreasing solverTolerance.\n";
+        }
+    }
+
+    // Keep the change in the solution from the first solve of the time step as the initial guess for the next one
+    if (first_solve_of_time_step && userInputs.linear_solver_parameters.getInitialGuessType(fieldIndex) == PREVIOUS_CHANGE){
+        *solutionChangeHistorySet[fieldIndex][0] = dU;
+        solutionChangeDtHistorySet[fieldIndex][0] = userInputs.dtValue;
+        solutionChangeHistorySize[fieldIndex] = 1;
+    }
+}
+
+// Get one of the preallocated scratch vectors with the layout of a field (they are only valid until the next use by another method)
+template <int dim, int degree>
+vectorType & MatrixFreePDE<dim,degree>::getScratchVector(unsigned int fieldIndex, unsigned int index){
+    if (fields[fieldIndex].type == SCALAR){
+        return scratchVectorsScalar.at(index);
+    }
+    else {
+        return scratchVectorsVector.at(index);
+    }
+}
+
+// Compute the residual of a non-explicit field, clear it at the Dirichlet DOFs, and return its norm
+template <int dim, int degree>
+double MatrixFreePDE<dim,degree>::computeNonexplicitResidualNorm(unsigned int fieldIndex){
+
+    computeNonexplicitRHS(fieldIndex);
+
+    zeroDirichletDoFs(*residualSet[fieldIndex], fieldIndex);
+
+    return residualSet[fieldIndex]->l2_norm();
+}
+
+// Take one inexact Newton step for a nonlinear field. The LHS supplied by the user is the action of the Jacobian on the
+// change in the solution, so the Newton system is solved matrix-free by the usual linear solver. Its tolerance is set by
+// the Eisenstat-Walker forcing term (choice 2) and the step is shortened until the residual satisfies the Armijo
+// sufficient decrease condition. Returns true if the field has converged.
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::solveNewtonKrylovStep(unsigned int fieldIndex, unsigned int nonlinear_it_index, bool first_solve_of_time_step){
+
+    char buffer[200];
+    NonlinearSolverParameters & nonlinear_parameters = userInputs.nonlinear_solver_parameters;
+
+    double residual_norm = computeNonexplicitResidualNorm(fieldIndex);
+    if (nonlinear_it_index == 0){
+        newtonInitialResidualSet[fieldIndex] = residual_norm;
+    }
+
+    // The residual the field has to reach (zero for the solution change tolerance, which is checked after the step)
+    double residual_tolerance = 0.0;
+    if (nonlinear_parameters.getToleranceType(fieldIndex) == ABSOLUTE_RESIDUAL){
+        residual_tolerance = nonlinear_parameters.getToleranceValue(fieldIndex);
+    }
+    else if (nonlinear_parameters.getToleranceType(fieldIndex) == RELATIVE_RESIDUAL_CHANGE){
+        residual_tolerance = nonlinear_parameters.getToleranceValue(fieldIndex)*newtonInitialResidualSet[fieldIndex];
+    }
+
+    if (residual_norm <= residual_tolerance){
+        if (currentIncrement%userInputs.skip_print_steps==0){
+            sprintf(buffer, "field '%2s' [Newton-Krylov solve]: converged, current residual:%12.6e, tolerance criterion:%12.6e\n", \
+            fields[fieldIndex].name.c_str(),			\
+            residual_norm, residual_tolerance);
+            pcout<<buffer;
+        }
+        return true;
+    }
+
+    // Choose the forcing term (the linear solver tolerance relative to the residual)
+    double forcing_term = nonlinear_parameters.getInitialForcingTerm(fieldIndex);
+    if (nonlinear_it_index > 0 && newtonResidualSet[fieldIndex] > 0.0){
+        const double gamma = 0.9;
+        double residual_ratio = residual_norm/newtonResidualSet[fieldIndex];
+        forcing_term = gamma*residual_ratio*residual_ratio;
+
+        // Safeguard against the forcing term decreasing too quickly
+        double previous_forcing_term_bound = gamma*newtonForcingTermSet[fieldIndex]*newtonForcingTermSet[fieldIndex];
+        if (previous_forcing_term_bound > 0.1){
+            forcing_term = std::max(forcing_term, previous_forcing_term_bound);
+        }
+    }
+    // Don't solve the linear system much more accurately than needed to reach the nonlinear tolerance
+    forcing_term = std::max(forcing_term, 0.5*residual_tolerance/residual_norm);
+    forcing_term = std::min(forcing_term, nonlinear_parameters.getMaxForcingTerm(fieldIndex));
+
+    newtonResidualSet[fieldIndex] = residual_norm;
+    newtonForcingTermSet[fieldIndex] = forcing_term;
+
+    SolverControl solver_control(userInputs.linear_solver_parameters.getMaxIterations(fieldIndex), forcing_term*residual_norm);
+    solveLinearSystem(fieldIndex, solver_control, first_solve_of_time_step);
+
+    vectorType & dU = (fields[fieldIndex].type == SCALAR) ? dU_scalar : dU_vector;
+
+    // Backtrack until the decrease in the residual is at least a fraction of the decrease predicted by the linear solve.
+    // A rejected step is undone by subtracting it, so no copy of the solution is needed.
+    double armijo_coeff = nonlinear_parameters.getArmijoCoeff(fieldIndex);
+    double step_length = 1.0;
+    double residual_new;
+    while (true){
+        solutionSet[fieldIndex]->add(step_length,dU);
+        residual_new = computeNonexplicitResidualNorm(fieldIndex);
+
+        if (residual_new <= (1.0 - armijo_coeff*step_length*(1.0 - forcing_term))*residual_norm || step_length < 1.0e-4){
+            break;
+        }
+        solutionSet[fieldIndex]->add(-step_length,dU);
+        step_length *= nonlinear_parameters.getBacktrackStepModifier(fieldIndex);
+    }
+
+    double step_norm = step_length*dU.l2_norm();
+
+    if (currentIncrement%userInputs.skip_print_steps==0){
+        sprintf(buffer, "field '%2s' [Newton-Krylov solve]: residual:%12.6e, new residual:%12.6e, forcing term:%12.6e, nsteps:%u, step length:%12.6e, dU: %12.6e\n", \
+        fields[fieldIndex].name.c_str(),			\
+        residual_norm, residual_new, forcing_term,	\
+        solver_control.last_step(), step_length, step_norm);
+        pcout<<buffer;
+    }
+
+    if (nonlinear_parameters.getToleranceType(fieldIndex) == ABSOLUTE_SOLUTION_CHANGE){
+        return (step_norm <= nonlinear_parameters.getToleranceValue(fieldIndex));
+    }
+    else {
+        return (residual_new <= residual_tolerance);
+    }
+}
+
+// Anderson acceleration of the fixed-point iteration x_{k+1} = G(x_k) of an auxiliary field. The new iterate is the
+// mixture g_k - sum_i gamma_i (g_i - g_{i-1}) of the stored iterates g = G(x), where gamma minimizes the norm of the mixed
+// residual f_k - sum_i gamma_i (f_i - f_{i-1}) with f = G(x) - x. On entry the solution holds g_k and dU holds x_k - g_k.
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::applyAndersonAcceleration(unsigned int fieldIndex){
+
+    std::vector<vectorType*> & history = andersonHistorySet[fieldIndex];
+    unsigned int depth = (history.size()-2)/2;
+    vectorType & previous_residual = *history[2*depth];
+    vectorType & previous_solution = *history[2*depth+1];
+
+    vectorType & residual = (fields[fieldIndex].type == SCALAR) ? dU_scalar : dU_vector;
+    residual *= -1.0;
+
+    // Store the differences from the last iterate of this solve in the oldest slots of the rings
+    if (andersonIterateCount[fieldIndex] > 0){
+        unsigned int slot = (andersonIterateCount[fieldIndex]-1)%depth;
+        *history[slot] = residual;
+        history[slot]->add(-1.0, previous_residual);
+        *history[depth+slot] = *solutionSet[fieldIndex];
+        history[depth+slot]->add(-1.0, previous_solution);
+    }
+    previous_residual = residual;
+    previous_solution = *solutionSet[fieldIndex];
+
+    unsigned int n_stored = std::min(andersonIterateCount[fieldIndex], depth);
+    andersonIterateCount[fieldIndex]++;
+    if (n_stored == 0){
+        return;
+    }
+
+    // Solve the least squares problem through its normal equations, which are regularized slightly in case the stored differences are nearly dependent
+    FullMatrix<double> normal_matrix(n_stored,n_stored);
+    dealii::Vector<double> normal_rhs(n_stored), gamma(n_stored);
+    double trace = 0.0;
+    for (unsigned int i=0; i<n_stored; i++){
+        for (unsigned int j=0; j<=i; j++){
+            normal_matrix(i,j) = (*history[i]) * (*history[j]);
+            normal_matrix(j,i) = normal_matrix(i,j);
+        }
+        normal_rhs(i) = (*history[i]) * residual;
+        trace += normal_matrix(i,i);
+    }
+    if (trace == 0.0){
+        return;
+    }
+    for (unsigned int i=0; i<n_stored; i++){
+        normal_matrix(i,i) += 1.0e-10*trace/n_stored;
+    }
+    normal_matrix.gauss_jordan();
+    normal_matrix.vmult(gamma, normal_rhs);
+
+    for (unsigned int i=0; i<n_stored; i++){
+        solutionSet[fieldIndex]->add(-gamma(i), *history[depth+i]);
+    }
+}
+
+// Set the initial guess for the change in the solution from the changes over the previous time steps. Until enough
+// time steps are stored, the extrapolation falls back to a lower order (and to a zero initial guess).
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::setLinearSolverInitialGuess(unsigned int fieldIndex, vectorType & dU){
+
+    LinearSolverInitialGuessType initial_guess_type = userInputs.linear_solver_parameters.getInitialGuessType(fieldIndex);
+    const std::vector<vectorType*> & change_history = solutionChangeHistorySet[fieldIndex];
+    const std::vector<double> & dt_history = solutionChangeDtHistorySet[fieldIndex];
+    unsigned int n_stored = solutionChangeHistorySize[fieldIndex];
+    double dt = userInputs.dtValue;
+
+    if (initial_guess_type == PREVIOUS_CHANGE && n_stored > 0){
+        dU = *change_history[0];
+    }
+    else if (initial_guess_type == QUADRATIC_EXTRAPOLATION && n_stored > 1){
+        // The changes over the last two time steps give the rate of change at their midpoints, and the rate of
+        // change is extrapolated linearly over the current time step (this is exact for a quadratic in time)
+        double quadratic_coeff = (dt*dt + dt*dt_history[0])/(dt_history[0] + dt_history[1]);
+        dU.equ((dt + quadratic_coeff)/dt_history[0], *change_history[0]);
+        dU.add(-quadratic_coeff/dt_history[1], *change_history[1]);
+    }
+    else if ((initial_guess_type == LINEAR_EXTRAPOLATION || initial_guess_type == QUADRATIC_EXTRAPOLATION) && n_stored > 0){
+        dU.equ(dt/dt_history[0], *change_history[0]);
+    }
+    else {
+        return;
+    }
+
+    // The change in the solution is zero at the Dirichlet DOFs
+    zeroDirichletDoFs(dU, fieldIndex);
+}
+
+// Copy the solution at the start of the time step for each field with an extrapolated initial guess (into the last vector of its history)
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::storeSolutionForChangeHistory(){
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        if (solutionChangeHistorySet[fieldIndex].size() > 1){
+            *solutionChangeHistorySet[fieldIndex].back() = *solutionSet[fieldIndex];
+        }
+    }
+}
+
+// Turn the stored solution at the start of the time step into the change over the time step and make it the newest
+// entry of the history (the oldest entry is then reused for the solution at the start of the next time step)
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::updateSolutionChangeHistory(){
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        std::vector<vectorType*> & change_history = solutionChangeHistorySet[fieldIndex];
+        std::vector<double> & dt_history = solutionChangeDtHistorySet[fieldIndex];
+
+        if (change_history.size() > 1){
+            change_history.back()->sadd(-1.0, 1.0, *solutionSet[fieldIndex]);
+            dt_history.back() = userInputs.dtValue;
+
+            std::rotate(change_history.begin(), change_history.end()-1, change_history.end());
+            std::rotate(dt_history.begin(), dt_history.end()-1, dt_history.end());
+
+            solutionChangeHistorySize[fieldIndex] = std::min(solutionChangeHistorySize[fieldIndex]+1, (unsigned int)change_history.size()-1);
+        }
+    }
+}
+
+// Check whether a time-independent field can keep the solution from its last solve. It is solved at least every "Solve
+// interval" increments and, with a solve change threshold, also whenever one of the fields it depends on has changed by
+// more than the threshold (in the max norm) since the last solve. A field with time-dependent non-uniform Dirichlet BCs
+// is solved every increment, since its boundary values change every time step.
+template <int dim, int degree>
+bool MatrixFreePDE<dim,degree>::reuseLastSolution(unsigned int fieldIndex){
+
+    if (lastSolveIncrementSet[fieldIndex] < 0){
+        return false;
+    }
+
+    if (userInputs.time_dependent_nonuniform_BCs && hasNonUniformDirichletBCs(fieldIndex)){
+        return false;
+    }
+
+    int increments_since_solve = (int)currentIncrement - lastSolveIncrementSet[fieldIndex];
+    if (increments_since_solve >= (int)userInputs.linear_solver_parameters.getSolveInterval(fieldIndex)){
+        return false;
+    }
+
+    double change_threshold = userInputs.linear_solver_parameters.getSolveChangeThreshold(fieldIndex);
+    for (unsigned int i=0; i<dependencySnapshotSet[fieldIndex].size(); i++){
+        const vectorType & snapshot = *dependencySnapshotSet[fieldIndex][i];
+        const vectorType & current = *solutionSet[userInputs.var_dependencies_nonexplicit[fieldIndex][i]];
+
+        double local_max_change = 0.0;
+        for (unsigned int dof=0; dof<snapshot.local_size(); ++dof){
+            local_max_change = std::max(local_max_change, std::abs(current.local_element(dof) - snapshot.local_element(dof)));
+        }
+        if (Utilities::MPI::max(local_max_change, MPI_COMM_WORLD) > change_threshold){
+            return false;
+        }
+    }
+
+    if (currentIncrement%userInputs.skip_print_steps==0){
+        pcout << "field '" << fields[fieldIndex].name << "' [implicit solve]: skipped, keeping the solution from increment " << lastSolveIncrementSet[fieldIndex] << std::endl;
+    }
+    return true;
+}
+
+// Record the increment of the solve of a time-independent field and copy the fields it depends on for reuseLastSolution()
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::storeLastSolve(unsigned int fieldIndex){
+    lastSolveIncrementSet[fieldIndex] = currentIncrement;
+    for (unsigned int i=0; i<dependencySnapshotSet[fieldIndex].size(); i++){
+        *dependencySnapshotSet[fieldIndex][i] = *solutionSet[userInputs.var_dependencies_nonexplicit[fieldIndex][i]];
+    }
+}
+
+// Copy the solution of each implicit time-dependent field into its old solution vector (including the ghost values)
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::storeOldSolution(){
+    for(unsigned int fieldIndex=0; fieldIndex<fields.size(); fieldIndex++){
+        if (oldSolutionSet[fieldIndex] != NULL){
+            *oldSolutionSet[fieldIndex] = *solutionSet[fieldIndex];
+            oldSolutionSet[fieldIndex]->update_ghost_values();
+        }
+    }
+}
+
 #include "../../include/matrixFreePDE_template_instantiations.h"
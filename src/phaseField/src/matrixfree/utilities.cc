@@ -12,5 +12,43 @@ unsigned int MatrixFreePDE<dim,degree>::getFieldIndex(std::string _name) {
    exit(-1);
 }
 
+//return the variable container for the given MatrixFree object and variable list for the current thread, creating it if it doesn't exist yet
+template <int dim, int degree>
+variableContainer<dim,degree,dealii::VectorizedArray<double> > & MatrixFreePDE<dim,degree>::getVariableContainer(const MatrixFree<dim,double> &data,
+                                                                                                                const std::vector<variable_info> &varInfoList,
+                                                                                                                const std::vector<variable_info> * varChangeInfoList,
+                                                                                                                bool fixed_index) const {
+   variableContainerCacheType & cache = variableContainerCache.get();
+   std::pair<const MatrixFree<dim,double>*,const std::vector<variable_info>*> key(&data,&varInfoList);
+
+   typename variableContainerCacheType::iterator it = cache.find(key);
+   if (it == cache.end()){
+     // Fields that share a DoF handler share an entry of matrixFreeObject, the multigrid level MatrixFree objects have one entry per field
+     std::vector<unsigned int> dof_indices;
+     if (&data == &matrixFreeObject){
+       dof_indices = dofIndexSet;
+     }
+
+     variableContainer<dim,degree,dealii::VectorizedArray<double> > * variable_list;
+     if (varChangeInfoList != NULL){
+       variable_list = new variableContainer<dim,degree,dealii::VectorizedArray<double> >(data,varInfoList,*varChangeInfoList,dof_indices);
+     }
+     else if (fixed_index){
+       variable_list = new variableContainer<dim,degree,dealii::VectorizedArray<double> >(data,varInfoList,0);
+     }
+     else {
+       variable_list = new variableContainer<dim,degree,dealii::VectorizedArray<double> >(data,varInfoList,dof_indices);
+     }
+     it = cache.insert(std::make_pair(key,std_cxx11::shared_ptr<variableContainer<dim,degree,dealii::VectorizedArray<double> > >(variable_list))).first;
+   }
+   return *(it->second);
+}
+
+//delete the cached variable containers of all threads
+template <int dim, int degree>
+void MatrixFreePDE<dim,degree>::clearVariableContainerCache() {
+   variableContainerCache.clear();
+}
+
 #include "../../include/matrixFreePDE_template_instantiations.h"
 
@@ -13,6 +13,18 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 
     var_nonlinear = variable_attributes.var_nonlinear;
 
+    // Collect the other variables each non-explicit equation depends on (on either side)
+    const EquationDependencyParser & parser = variable_attributes.equation_dependency_parser;
+    var_dependencies_nonexplicit.resize(number_of_variables);
+    for (unsigned int i=0; i<number_of_variables; i++){
+        for (unsigned int j=0; j<number_of_variables; j++){
+            if (j != i && (parser.eq_need_value_nonexplicit_RHS[i][j] || parser.eq_need_gradient_nonexplicit_RHS[i][j] || parser.eq_need_hessian_nonexplicit_RHS[i][j]
+                || parser.eq_need_value_nonexplicit_LHS[i][j] || parser.eq_need_gradient_nonexplicit_LHS[i][j] || parser.eq_need_hessian_nonexplicit_LHS[i][j])){
+                var_dependencies_nonexplicit[i].push_back(j);
+            }
+        }
+    }
+
     pp_calc_integral = variable_attributes.pp_calc_integral;
 
     pp_number_of_variables = variable_attributes.pp_number_of_variables;
@@ -51,6 +63,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	unsigned int vector_var_index = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
 
         varInfo.need_value = variable_attributes.equation_dependency_parser.need_value_explicit_RHS[i];
         varInfo.need_gradient = variable_attributes.equation_dependency_parser.need_gradient_explicit_RHS[i];
@@ -60,12 +73,8 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 
         varInfo.global_var_index = i;
 
-		if (varInfo.need_value or varInfo.need_gradient or varInfo.need_hessian){
-            varInfo.var_needed = true;
-		}
-        else {
-            varInfo.var_needed = false;
-        }
+        // A variable with a residual needs an FEEvaluation object even if its value isn't used
+        varInfo.var_needed = varInfo.need_value || varInfo.need_gradient || varInfo.need_hessian || varInfo.value_residual || varInfo.gradient_residual;
 
         if (var_type[i] == SCALAR){
             varInfo.is_scalar = true;
@@ -97,6 +106,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	vector_var_index = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
 
         varInfo.need_value = variable_attributes.equation_dependency_parser.need_value_nonexplicit_RHS[i];
         varInfo.need_gradient = variable_attributes.equation_dependency_parser.need_gradient_nonexplicit_RHS[i];
@@ -131,6 +141,160 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
         varInfoListNonexplicitRHS.push_back(varInfo);
 	}
 
+    // Load the number of substeps of each explicit field and the variable information for calculating the RHS in each
+    // substep after the first one (the variables are the same as for all of the explicit equations, but only the fields
+    // that take the substep have residuals)
+    var_explicit_subcycling_steps = variable_attributes.var_explicit_subcycling_steps;
+    max_explicit_subcycling_steps = 1;
+    for (unsigned int i=0; i<number_of_variables; i++){
+        if (var_explicit_subcycling_steps[i] == 0){
+            std::cerr << "PRISMS-PF Error: The number of explicit subcycling steps for variable " << var_name[i] << " must be a positive integer." << std::endl;
+            abort();
+        }
+        if (var_explicit_subcycling_steps[i] > 1 && var_eq_type[i] != EXPLICIT_TIME_DEPENDENT){
+            std::cerr << "PRISMS-PF Error: Subcycling steps were set for variable " << var_name[i] << ", but only explicit time-dependent fields can be subcycled." << std::endl;
+            abort();
+        }
+        // The substeps of all of the subcycled fields are taken together, so they must all take the same number of them
+        // (otherwise the fields would be at different times within the time step when their RHS is calculated)
+        if (var_explicit_subcycling_steps[i] > 1 && max_explicit_subcycling_steps > 1 && var_explicit_subcycling_steps[i] != max_explicit_subcycling_steps){
+            std::cerr << "PRISMS-PF Error: All of the subcycled explicit fields must take the same number of substeps, but variable " << var_name[i] << " takes " << var_explicit_subcycling_steps[i] << " substeps instead of " << max_explicit_subcycling_steps << "." << std::endl;
+            abort();
+        }
+        max_explicit_subcycling_steps = std::max(max_explicit_subcycling_steps, var_explicit_subcycling_steps[i]);
+    }
+
+    for (unsigned int substep=1; substep<max_explicit_subcycling_steps; substep++){
+        std::vector<variable_info> substep_varInfoList = varInfoListExplicitRHS;
+        scalar_var_index = 0;
+        vector_var_index = 0;
+        for (unsigned int i=0; i<number_of_variables; i++){
+            variable_info & varInfo = substep_varInfoList[i];
+            if (var_explicit_subcycling_steps[i] <= substep){
+                varInfo.value_residual = false;
+                varInfo.gradient_residual = false;
+            }
+            varInfo.var_needed = varInfo.need_value || varInfo.need_gradient || varInfo.need_hessian || varInfo.value_residual || varInfo.gradient_residual;
+
+            if (varInfo.var_needed){
+                if (varInfo.is_scalar){
+                    varInfo.scalar_or_vector_index = scalar_var_index;
+                    scalar_var_index++;
+                }
+                else {
+                    varInfo.scalar_or_vector_index = vector_var_index;
+                    vector_var_index++;
+                }
+            }
+        }
+        varInfoListExplicitRHSSubcycle.push_back(substep_varInfoList);
+    }
+
+    // Load variable information for calculating the mass terms of the explicit equations (used with local time stepping)
+	scalar_var_index = 0;
+	vector_var_index = 0;
+	for (unsigned int i=0; i<number_of_variables; i++){
+		variable_info varInfo;
+        varInfo.need_old_value = false;
+
+        varInfo.var_needed = (var_eq_type[i] == EXPLICIT_TIME_DEPENDENT);
+        varInfo.need_value = varInfo.var_needed;
+        varInfo.need_gradient = false;
+        varInfo.need_hessian = false;
+        varInfo.value_residual = varInfo.var_needed;
+        varInfo.gradient_residual = false;
+
+        varInfo.global_var_index = i;
+
+        if (var_type[i] == SCALAR){
+            varInfo.is_scalar = true;
+            if (varInfo.var_needed){
+                varInfo.scalar_or_vector_index = scalar_var_index;
+                scalar_var_index++;
+            }
+        }
+        else {
+            varInfo.is_scalar = false;
+            if (varInfo.var_needed){
+                varInfo.scalar_or_vector_index = vector_var_index;
+                vector_var_index++;
+            }
+        }
+
+        varInfoListExplicitMass.push_back(varInfo);
+	}
+
+    // The old values (from the start of the time step) of implicit time-dependent variables for the nonexplicit RHS
+	scalar_var_index = 0;
+	vector_var_index = 0;
+	for (unsigned int i=0; i<number_of_variables; i++){
+        varInfoListNonexplicitRHS[i].need_old_value = variable_attributes.equation_dependency_parser.need_value_old_nonexplicit_RHS[i];
+        if (varInfoListNonexplicitRHS[i].need_old_value){
+            if (var_type[i] == SCALAR){
+                varInfoListNonexplicitRHS[i].old_scalar_or_vector_index = scalar_var_index;
+                scalar_var_index++;
+            }
+            else {
+                varInfoListNonexplicitRHS[i].old_scalar_or_vector_index = vector_var_index;
+                vector_var_index++;
+            }
+        }
+	}
+
+    // Load variable information for calculating the RHS of each nonexplicit equation on its own. Only the variables
+    // that equation depends on are evaluated and only its own residual is integrated (so the variable for the residual
+    // always gets an FEEvaluation object, even if its value isn't needed).
+    varInfoListNonexplicitRHSByField.resize(number_of_variables);
+    for (unsigned int field=0; field<number_of_variables; field++){
+        if (var_eq_type[field] == EXPLICIT_TIME_DEPENDENT){
+            continue;
+        }
+
+        scalar_var_index = 0;
+        vector_var_index = 0;
+        unsigned int old_scalar_var_index = 0;
+        unsigned int old_vector_var_index = 0;
+        for (unsigned int i=0; i<number_of_variables; i++){
+            variable_info varInfo;
+
+            varInfo.need_value = parser.eq_need_value_nonexplicit_RHS[field][i];
+            varInfo.need_gradient = parser.eq_need_gradient_nonexplicit_RHS[field][i];
+            varInfo.need_hessian = parser.eq_need_hessian_nonexplicit_RHS[field][i];
+            varInfo.value_residual = (i == field) && parser.need_value_residual_nonexplicit_RHS[i];
+            varInfo.gradient_residual = (i == field) && parser.need_gradient_residual_nonexplicit_RHS[i];
+
+            varInfo.global_var_index = i;
+
+            varInfo.var_needed = varInfo.need_value || varInfo.need_gradient || varInfo.need_hessian || varInfo.value_residual || varInfo.gradient_residual;
+
+            varInfo.is_scalar = (var_type[i] == SCALAR);
+            if (varInfo.var_needed){
+                if (varInfo.is_scalar){
+                    varInfo.scalar_or_vector_index = scalar_var_index;
+                    scalar_var_index++;
+                }
+                else {
+                    varInfo.scalar_or_vector_index = vector_var_index;
+                    vector_var_index++;
+                }
+            }
+
+            varInfo.need_old_value = parser.eq_need_value_old_nonexplicit_RHS[field][i];
+            if (varInfo.need_old_value){
+                if (varInfo.is_scalar){
+                    varInfo.old_scalar_or_vector_index = old_scalar_var_index;
+                    old_scalar_var_index++;
+                }
+                else {
+                    varInfo.old_scalar_or_vector_index = old_vector_var_index;
+                    old_vector_var_index++;
+                }
+            }
+
+            varInfoListNonexplicitRHSByField[field].push_back(varInfo);
+        }
+    }
+
 	// Load variable information for calculating the LHS
 	num_var_LHS = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
@@ -144,6 +308,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	vector_var_index = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
 
         varInfo.need_value = variable_attributes.equation_dependency_parser.need_value_nonexplicit_LHS[i];
         varInfo.need_gradient = variable_attributes.equation_dependency_parser.need_gradient_nonexplicit_LHS[i];
@@ -184,6 +349,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	vector_var_index = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
 
         varInfo.need_value = variable_attributes.equation_dependency_parser.need_value_change_nonexplicit_LHS[i];
         varInfo.need_gradient = variable_attributes.equation_dependency_parser.need_gradient_change_nonexplicit_LHS[i];
@@ -227,6 +393,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	vector_var_index = 0;
 	for (unsigned int i=0; i<number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
 
         varInfo.need_value = variable_attributes.equation_dependency_parser.pp_need_value[i];
         varInfo.need_gradient = variable_attributes.equation_dependency_parser.pp_need_gradient[i];
@@ -282,6 +449,7 @@ void userInputParameters<dim>::loadVariableAttributes(variableAttributeLoader va
 	vector_var_index = 0;
 	for (unsigned int i=0; i<pp_number_of_variables; i++){
 		variable_info varInfo;
+        varInfo.need_old_value = false;
         varInfo.var_needed = true;
 
         varInfo.value_residual = variable_attributes.equation_dependency_parser.pp_need_value_residual[i];
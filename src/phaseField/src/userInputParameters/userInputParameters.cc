@@ -70,7 +70,69 @@ userInputParameters<dim>::userInputParameters(inputFileReader & input_file_reade
     int totalIncrements_temp = parameter_handler.get_integer("Number of time steps");
     finalTime = parameter_handler.get_double("Simulation end time");
 
+    adaptive_time_stepping = parameter_handler.get_bool("Adaptive time stepping");
+    adaptive_time_step_tolerance = parameter_handler.get_double("Adaptive time stepping tolerance");
+    max_dtValue = parameter_handler.get_double("Maximum time step");
+    if (max_dtValue < 0.0){
+        max_dtValue = dtValue;
+    }
+    stable_dtValue = parameter_handler.get_double("Stable time step");
+    if (stable_dtValue < 0.0){
+        stable_dtValue = dtValue;
+    }
+    min_dtValue = parameter_handler.get_double("Minimum time step");
+    if (min_dtValue < 0.0){
+        min_dtValue = 0.01*dtValue;
+    }
+    if (adaptive_time_stepping && (adaptive_time_step_tolerance <= 0.0 || min_dtValue > max_dtValue || min_dtValue > stable_dtValue)){
+        std::cerr << "PRISMS-PF Error: The adaptive time stepping tolerance must be positive and the minimum time step can't be larger than the maximum or the stable time step." << std::endl;
+        abort();
+    }
+
+    // Local time stepping parameters
+    int local_time_step_groups_temp = parameter_handler.get_integer("Local time stepping groups");
+    if (local_time_step_groups_temp < 1){
+        std::cerr << "PRISMS-PF Error: The number of local time stepping groups must be a positive integer." << std::endl;
+        abort();
+    }
+    local_time_step_groups = local_time_step_groups_temp;
+    if (local_time_step_groups > 1 && adaptive_time_stepping){
+        std::cerr << "PRISMS-PF Error: Local time stepping can't be used with adaptive time stepping." << std::endl;
+        abort();
+    }
+    if (local_time_step_groups > 1 && max_explicit_subcycling_steps > 1){
+        std::cerr << "PRISMS-PF Error: Local time stepping can't be used with explicit subcycling." << std::endl;
+        abort();
+    }
+    // The mesh can only change when the steps of all of the groups end together
+    if (local_time_step_groups > 1 && h_adaptivity && skip_remeshing_steps%(1 << (local_time_step_groups-1)) != 0){
+        std::cerr << "PRISMS-PF Error: With local time stepping, the number of steps between remeshing operations must be a multiple of the time step ratio of the coarsest group (2^(number of groups - 1))." << std::endl;
+        abort();
+    }
+
+    // The adaptive time step is set from the rate change of a single explicit update per time step
+    if (max_explicit_subcycling_steps > 1 && adaptive_time_stepping){
+        std::cerr << "PRISMS-PF Error: Explicit subcycling can't be used with adaptive time stepping." << std::endl;
+        abort();
+    }
+
+    // Parallelization parameters
+    int number_of_threads_temp = parameter_handler.get_integer("Number of threads per process");
+    if (number_of_threads_temp > 0){
+        number_of_threads = number_of_threads_temp;
+    }
+    else if (number_of_threads_temp == -1){
+        number_of_threads = dealii::numbers::invalid_unsigned_int;
+    }
+    else {
+        std::cerr << "PRISMS-PF Error: The number of threads per process must be a positive integer (or -1 to use all available cores)." << std::endl;
+        abort();
+    }
+
+    share_dof_handlers = parameter_handler.get_bool("Share DoF handlers between fields");
+
     // Linear solver parameters
+    use_multigrid = false;
     for (unsigned int i=0; i<number_of_variables; i++){
         if (input_file_reader.var_eq_types.at(i) == TIME_INDEPENDENT || input_file_reader.var_eq_types.at(i) == IMPLICIT_TIME_DEPENDENT){
             std::string subsection_text = "Linear solver parameters: ";
@@ -103,7 +165,91 @@ userInputParameters<dim>::userInputParameters(inputFileReader & input_file_reade
                 // Set the maximum number of iterations
                 unsigned int temp_max_iterations = parameter_handler.get_integer("Maximum linear solver iterations");
 
-                linear_solver_parameters.loadParameters(i,temp_type,temp_value,temp_max_iterations);
+                // Set the preconditioner
+                LinearSolverPreconditionerType temp_preconditioner_type;
+                std::string preconditioner_string = parameter_handler.get("Preconditioner type");
+                if (boost::iequals(preconditioner_string,"NONE")){
+                    temp_preconditioner_type = NO_PRECONDITIONER;
+                }
+                else if (boost::iequals(preconditioner_string,"JACOBI")){
+                    temp_preconditioner_type = JACOBI;
+                }
+                else if (boost::iequals(preconditioner_string,"CHEBYSHEV")){
+                    temp_preconditioner_type = CHEBYSHEV;
+                }
+                else if (boost::iequals(preconditioner_string,"MULTIGRID")){
+                    temp_preconditioner_type = MULTIGRID;
+                    #if (DEAL_II_VERSION_MAJOR < 9)
+                        std::cerr << "PRISMS-PF Error: The MULTIGRID preconditioner requires deal.II version 9.0 or later." << std::endl;
+                        abort();
+                    #endif
+                    use_multigrid = true;
+                }
+                else {
+                    std::cerr << "PRISMS-PF Error: Linear solver preconditioner type " << preconditioner_string << " is not one of the allowed values (NONE, JACOBI, CHEBYSHEV, MULTIGRID)" << std::endl;
+                    abort();
+                }
+
+                unsigned int temp_chebyshev_degree = parameter_handler.get_integer("Chebyshev polynomial degree");
+                double temp_chebyshev_smoothing_range = parameter_handler.get_double("Chebyshev smoothing range");
+                if ((temp_preconditioner_type == CHEBYSHEV || temp_preconditioner_type == MULTIGRID) && (temp_chebyshev_degree < 1 || temp_chebyshev_smoothing_range <= 1.0)){
+                    std::cerr << "PRISMS-PF Error: The Chebyshev polynomial degree must be at least one and the Chebyshev smoothing range must be greater than one." << std::endl;
+                    abort();
+                }
+
+                // Set the precision of the stored inverse of the LHS diagonal
+                PreconditionerPrecisionType temp_preconditioner_precision;
+                std::string precision_string = parameter_handler.get("Preconditioner precision");
+                if (boost::iequals(precision_string,"DOUBLE")){
+                    temp_preconditioner_precision = DOUBLE_PRECISION;
+                }
+                else if (boost::iequals(precision_string,"SINGLE")){
+                    temp_preconditioner_precision = SINGLE_PRECISION;
+                }
+                else {
+                    std::cerr << "PRISMS-PF Error: Preconditioner precision " << precision_string << " is not one of the allowed values (DOUBLE, SINGLE)" << std::endl;
+                    abort();
+                }
+                if (temp_preconditioner_precision == SINGLE_PRECISION && temp_preconditioner_type != JACOBI && temp_preconditioner_type != CHEBYSHEV){
+                    temp_preconditioner_precision = DOUBLE_PRECISION;
+                    if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
+                        std::cout << "PRISMS-PF Warning: Single precision storage is only used for the Jacobi and Chebyshev preconditioners. The linear solver for variable " << input_file_reader.var_names.at(i) << " doesn't use either of them, so its preconditioner precision is ignored." << std::endl;
+                    }
+                }
+
+                // Set the initial guess for the first linear solve of each time step
+                LinearSolverInitialGuessType temp_initial_guess_type;
+                std::string initial_guess_string = parameter_handler.get("Initial guess");
+                if (boost::iequals(initial_guess_string,"ZERO")){
+                    temp_initial_guess_type = ZERO_INITIAL_GUESS;
+                }
+                else if (boost::iequals(initial_guess_string,"PREVIOUS_CHANGE")){
+                    temp_initial_guess_type = PREVIOUS_CHANGE;
+                }
+                else if (boost::iequals(initial_guess_string,"LINEAR_EXTRAPOLATION")){
+                    temp_initial_guess_type = LINEAR_EXTRAPOLATION;
+                }
+                else if (boost::iequals(initial_guess_string,"QUADRATIC_EXTRAPOLATION")){
+                    temp_initial_guess_type = QUADRATIC_EXTRAPOLATION;
+                }
+                else {
+                    std::cerr << "PRISMS-PF Error: Linear solver initial guess " << initial_guess_string << " is not one of the allowed values (ZERO, PREVIOUS_CHANGE, LINEAR_EXTRAPOLATION, QUADRATIC_EXTRAPOLATION)" << std::endl;
+                    abort();
+                }
+
+                // Set how often a time-independent field is solved
+                int temp_solve_interval = parameter_handler.get_integer("Solve interval");
+                double temp_solve_change_threshold = parameter_handler.get_double("Solve change threshold");
+                if (temp_solve_interval < 1 || temp_solve_change_threshold < 0.0){
+                    std::cerr << "PRISMS-PF Error: The solve interval must be at least one and the solve change threshold can't be negative." << std::endl;
+                    abort();
+                }
+                if (input_file_reader.var_eq_types.at(i) == IMPLICIT_TIME_DEPENDENT && (temp_solve_interval > 1 || temp_solve_change_threshold > 0.0)){
+                    std::cerr << "PRISMS-PF Error: The solve of implicit time-dependent field " << input_file_reader.var_names.at(i) << " can't be skipped, the solve interval and solve change threshold are only for time-independent fields." << std::endl;
+                    abort();
+                }
+
+                linear_solver_parameters.loadParameters(i,temp_type,temp_value,temp_max_iterations,temp_preconditioner_type,temp_chebyshev_degree,temp_chebyshev_smoothing_range,temp_initial_guess_type,temp_solve_interval,temp_solve_change_threshold,temp_preconditioner_precision);
             }
             parameter_handler.leave_subsection();
         }
@@ -166,7 +312,47 @@ userInputParameters<dim>::userInputParameters(inputFileReader & input_file_reade
                     }
                 }
 
-                nonlinear_solver_parameters.loadParameters(i,temp_type,temp_value,temp_backtrack_damping,temp_step_modifier,temp_residual_decrease_coeff,temp_damping_coefficient,temp_laplace_for_initial_guess);
+                // Set the nonlinear solver and the parameters of the Newton-Krylov solver
+                NonlinearSolverType temp_solver_type;
+                std::string solver_type_string = parameter_handler.get("Nonlinear solver type");
+                if (boost::iequals(solver_type_string,"DAMPED_ITERATION")){
+                    temp_solver_type = DAMPED_ITERATION;
+                }
+                else if (boost::iequals(solver_type_string,"NEWTON_KRYLOV")){
+                    temp_solver_type = NEWTON_KRYLOV;
+                    if (var_eq_type[i] != TIME_INDEPENDENT && var_eq_type[i] != IMPLICIT_TIME_DEPENDENT){
+                        std::cerr << "PRISMS-PF Error: The NEWTON_KRYLOV nonlinear solver is only available for time independent and implicit time dependent equations, not for variable " << var_name[i] << "." << std::endl;
+                        abort();
+                    }
+                }
+                else {
+                    std::cerr << "PRISMS-PF Error: Nonlinear solver type " << solver_type_string << " is not one of the allowed values (DAMPED_ITERATION, NEWTON_KRYLOV)" << std::endl;
+                    abort();
+                }
+
+                double temp_initial_forcing_term = parameter_handler.get_double("Initial forcing term");
+                double temp_max_forcing_term = parameter_handler.get_double("Maximum forcing term");
+                double temp_armijo_coeff = parameter_handler.get_double("Armijo sufficient decrease coefficient");
+                if (temp_solver_type == NEWTON_KRYLOV && (temp_initial_forcing_term <= 0.0 || temp_initial_forcing_term >= 1.0 || temp_max_forcing_term <= 0.0 || temp_max_forcing_term >= 1.0 || temp_armijo_coeff <= 0.0 || temp_armijo_coeff >= 1.0)){
+                    std::cerr << "PRISMS-PF Error: The forcing terms and the Armijo sufficient decrease coefficient for the NEWTON_KRYLOV nonlinear solver must be between zero and one." << std::endl;
+                    abort();
+                }
+
+                // Set the depth of the Anderson acceleration of the fixed-point iterations for auxiliary equations
+                int temp_anderson_depth = parameter_handler.get_integer("Anderson acceleration depth");
+                if (temp_anderson_depth < 0){
+                    std::cerr << "PRISMS-PF Error: The Anderson acceleration depth for variable " << var_name[i] << " must not be negative." << std::endl;
+                    abort();
+                }
+                if (temp_anderson_depth > 0 && var_eq_type[i] != AUXILIARY){
+                    temp_anderson_depth = 0;
+                    if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0){
+                        std::cout << "PRISMS-PF Warning: Anderson acceleration is only used for the fixed-point iterations of auxiliary equations. The equation for variable " << var_name[i] << " is not an auxiliary equation. Its nonlinear iterations won't be accelerated." << std::endl;
+                    }
+                }
+
+                nonlinear_solver_parameters.loadParameters(i,temp_type,temp_value,temp_backtrack_damping,temp_step_modifier,temp_residual_decrease_coeff,temp_damping_coefficient,temp_laplace_for_initial_guess,
+                    temp_solver_type,temp_initial_forcing_term,temp_max_forcing_term,temp_armijo_coeff,temp_anderson_depth);
             }
             parameter_handler.leave_subsection();
         }
@@ -282,6 +468,32 @@ userInputParameters<dim>::userInputParameters(inputFileReader & input_file_reade
 
     checkpointTimeStepList = setTimeStepList(checkpoint_condition, num_checkpoints,user_given_checkpoint_time_step_list);
 
+    // The times for the outputs and checkpoints, used in place of the increments with adaptive time stepping
+    for (unsigned int i=0; i<outputTimeStepList.size(); i++){
+        outputTimeList.push_back(outputTimeStepList[i]*dtValue);
+    }
+    for (unsigned int i=0; i<checkpointTimeStepList.size(); i++){
+        checkpointTimeList.push_back(checkpointTimeStepList[i]*dtValue);
+    }
+
+    // With local time stepping, the explicit fields are only at the same time in all of the cells after the increments
+    // that end the steps of all of the groups (those before every 2^(number of groups - 1)th increment)
+    if (local_time_step_groups > 1){
+        const unsigned int coarsest_group_steps = (1 << (local_time_step_groups-1));
+        for (unsigned int i=0; i<outputTimeStepList.size(); i++){
+            if (outputTimeStepList[i] > 0 && (outputTimeStepList[i]+1)%coarsest_group_steps != 0){
+                std::cerr << "PRISMS-PF Error: With local time stepping, the results can only be output at increments one less than a multiple of the time step ratio of the coarsest group (2^(number of groups - 1)), but an output is set for increment " << outputTimeStepList[i] << "." << std::endl;
+                abort();
+            }
+        }
+        for (unsigned int i=0; i<checkpointTimeStepList.size(); i++){
+            if (checkpointTimeStepList[i] > 0 && (checkpointTimeStepList[i]+1)%coarsest_group_steps != 0){
+                std::cerr << "PRISMS-PF Error: With local time stepping, checkpoints can only be saved at increments one less than a multiple of the time step ratio of the coarsest group (2^(number of groups - 1)), but a checkpoint is set for increment " << checkpointTimeStepList[i] << "." << std::endl;
+                abort();
+            }
+        }
+    }
+
     // Parameters for nucleation
 
     for (unsigned int i=0; i<input_file_reader.var_types.size(); i++){
@@ -398,6 +610,8 @@ userInputParameters<dim>::userInputParameters(inputFileReader & input_file_reade
     // Load the BC information from the strings into a varBCs object
     load_BC_list(list_of_BCs);
 
+    time_dependent_nonuniform_BCs = parameter_handler.get_bool("Time-dependent non-uniform Dirichlet BCs");
+
     // Load the user-defined constants
     load_user_constants(input_file_reader,parameter_handler);
 }
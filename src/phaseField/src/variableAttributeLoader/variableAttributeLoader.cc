@@ -24,6 +24,8 @@ variableAttributeLoader::variableAttributeLoader(){
     nucleating_variable = sortIndexEntryPairList(nucleating_variable_list,number_of_variables,false);
     need_value_nucleation = sortIndexEntryPairList(need_value_list_nucleation,number_of_variables,false);
 
+    var_explicit_subcycling_steps = sortIndexEntryPairList(explicit_subcycling_steps_list,number_of_variables,(unsigned int)1);
+
     equation_dependency_parser.parse(
         var_name,
         var_eq_type,
@@ -104,6 +106,12 @@ void variableAttributeLoader::set_output_integral(unsigned int index, bool flag)
     var_pair.second = flag;
     output_integral_list.push_back(var_pair);
 }
+void variableAttributeLoader::set_explicit_subcycling_steps(unsigned int index, unsigned int steps){
+    std::pair<unsigned int, unsigned int> var_pair;
+    var_pair.first = index;
+    var_pair.second = steps;
+    explicit_subcycling_steps_list.push_back(var_pair);
+}
 
 void variableAttributeLoader::set_dependencies_value_term_RHS(unsigned int index, std::string dependencies){
     std::pair<unsigned int, std::string> var_pair;
@@ -2,57 +2,94 @@
 #include "../../include/variableContainer.h"
 
 template <int dim, int degree, typename T>
-variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList, std::vector<variable_info> _varChangeInfoList)
+variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList, std::vector<variable_info> _varChangeInfoList,
+                                                   const std::vector<unsigned int> &_dof_indices)
 {
     varInfoList = _varInfoList;
     varChangeInfoList = _varChangeInfoList;
 
     num_var = varInfoList.size();
 
+    set_dof_indices(_dof_indices);
+
+    // The LHS reads the variable being solved for from a separate vector, so its variables aren't grouped into blocks
+    var_block_index.assign(num_var,-1);
+    var_block_component.assign(num_var,0);
+
     for (unsigned int i=0; i < num_var; i++){
         if (varInfoList[i].var_needed){
             if (varInfoList[i].is_scalar){
-                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, i);
+                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, var_dof_index[i]);
                 scalar_vars.push_back(var);
             }
             else {
-                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, i);
+                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, var_dof_index[i]);
                 vector_vars.push_back(var);
             }
         }
 
         if (varChangeInfoList[i].var_needed){
             if (varChangeInfoList[i].is_scalar){
-                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, i);
+                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, var_dof_index[i]);
                 scalar_change_in_vars.push_back(var);
             }
             else {
-                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, i);
+                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, var_dof_index[i]);
                 vector_change_in_vars.push_back(var);
             }
         }
     }
+
+    set_up_evaluation_steps();
 }
 
 template <int dim, int degree, typename T>
-variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList)
+variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,double> &data, std::vector<variable_info> _varInfoList,
+                                                   const std::vector<unsigned int> &_dof_indices)
 {
     varInfoList = _varInfoList;
 
     num_var = varInfoList.size();
 
+    set_dof_indices(_dof_indices);
+
+    set_up_scalar_blocks(data);
+
+    unsigned int scalar_index = 0;
     for (unsigned int i=0; i < num_var; i++){
         if (varInfoList[i].var_needed){
-            if (varInfoList[i].is_scalar){
-                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, i);
+            if (varInfoList[i].is_scalar && var_block_index[i] >= 0){
+                if (var_block_component[i] == 0){
+                    dealii::FEEvaluation<dim,degree,degree+1,scalar_block_size,double> var(data, var_dof_index[i]);
+                    scalar_block_vars.push_back(var);
+                }
+            }
+            else if (varInfoList[i].is_scalar){
+                // The scalar variables in blocks don't have their own FEEvaluation object, so the indices of the others are shifted
+                varInfoList[i].scalar_or_vector_index = scalar_index;
+                scalar_index++;
+                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, var_dof_index[i]);
                 scalar_vars.push_back(var);
             }
             else {
-                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, i);
+                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, var_dof_index[i]);
                 vector_vars.push_back(var);
             }
         }
+
+        if (varInfoList[i].need_old_value){
+            if (varInfoList[i].is_scalar){
+                dealii::FEEvaluation<dim,degree,degree+1,1,double> var(data, var_dof_index[i]);
+                scalar_old_vars.push_back(var);
+            }
+            else {
+                dealii::FEEvaluation<dim,degree,degree+1,dim,double> var(data, var_dof_index[i]);
+                vector_old_vars.push_back(var);
+            }
+        }
     }
+
+    set_up_evaluation_steps();
 }
 
 // Variant of the constructor where it reads from a fixed index of "data", used for post-processing
@@ -63,6 +100,9 @@ variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,
 
     num_var = varInfoList.size();
 
+    var_block_index.assign(num_var,-1);
+    var_block_component.assign(num_var,0);
+
     for (unsigned int i=0; i < num_var; i++){
         if (varInfoList[i].var_needed){
             if (varInfoList[i].is_scalar){
@@ -75,6 +115,99 @@ variableContainer<dim,degree,T>::variableContainer(const dealii::MatrixFree<dim,
             }
         }
     }
+
+    set_up_evaluation_steps();
+}
+
+// Set the DoF index of each variable in the MatrixFree object. Variables that share a DoF handler share its DoF index, so
+// the DoF index only matches the variable index if no dof_indices are given.
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_dof_indices(const std::vector<unsigned int> &dof_indices){
+    if (dof_indices.empty()){
+        var_dof_index.resize(num_var);
+        for (unsigned int i=0; i < num_var; i++){
+            var_dof_index[i] = i;
+        }
+    }
+    else {
+        var_dof_index = dof_indices;
+    }
+}
+
+// Group runs of scalar_block_size consecutive scalar variables into blocks. The variables in a block must use the same DoF
+// handler (i.e. the DoF handlers are shared between fields) and have the same evaluation and residual flags, since the
+// components of an FEEvaluation object are read, evaluated, and integrated together.
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_up_scalar_blocks(const dealii::MatrixFree<dim,double> &data){
+
+    var_block_index.assign(num_var,-1);
+    var_block_component.assign(num_var,0);
+
+    unsigned int i = 0;
+    while (i + scalar_block_size <= num_var){
+        const variable_info & first_var = varInfoList[i];
+        bool block_possible = true;
+        for (unsigned int c=0; c<scalar_block_size; c++){
+            const variable_info & var = varInfoList[i+c];
+            if (!var.var_needed || !var.is_scalar
+                || var.need_value != first_var.need_value || var.need_gradient != first_var.need_gradient || var.need_hessian != first_var.need_hessian
+                || var.value_residual != first_var.value_residual || var.gradient_residual != first_var.gradient_residual
+                || &data.get_dof_handler(var_dof_index[i+c]) != &data.get_dof_handler(var_dof_index[i])){
+                block_possible = false;
+                break;
+            }
+        }
+
+        if (block_possible){
+            for (unsigned int c=0; c<scalar_block_size; c++){
+                var_block_index[i+c] = block_first_var.size();
+                var_block_component[i+c] = c;
+            }
+            block_first_var.push_back(i);
+            i += scalar_block_size;
+        }
+        else {
+            i++;
+        }
+    }
+
+    block_value_residuals.resize(block_first_var.size());
+    block_gradient_residuals.resize(block_first_var.size());
+}
+
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::set_up_evaluation_steps(){
+
+    for (unsigned int i=0; i<num_var; i++){
+        // The variables in a block are read, evaluated, and integrated together with the first one
+        if (!varInfoList[i].var_needed || (var_block_index[i] >= 0 && var_block_component[i] != 0)){
+            continue;
+        }
+
+        evaluation_step step;
+        step.var_index = i;
+        // A variable may only be needed for its residual, then it isn't read or evaluated
+        step.evaluate = varInfoList[i].need_value || varInfoList[i].need_gradient || varInfoList[i].need_hessian;
+        step.need_value = varInfoList[i].need_value;
+        step.need_gradient = varInfoList[i].need_gradient;
+        step.need_hessian = varInfoList[i].need_hessian;
+        step.integrate = varInfoList[i].value_residual || varInfoList[i].gradient_residual;
+        step.value_residual = varInfoList[i].value_residual;
+        step.gradient_residual = varInfoList[i].gradient_residual;
+
+        if (var_block_index[i] >= 0){
+            step.fe_eval_index = var_block_index[i];
+            scalar_block_steps.push_back(step);
+        }
+        else if (varInfoList[i].is_scalar){
+            step.fe_eval_index = varInfoList[i].scalar_or_vector_index;
+            scalar_steps.push_back(step);
+        }
+        else {
+            step.fe_eval_index = varInfoList[i].scalar_or_vector_index;
+            vector_steps.push_back(step);
+        }
+    }
 }
 
 template <int dim, int degree, typename T>
@@ -83,6 +216,9 @@ void variableContainer<dim,degree,T>::get_JxW(dealii::AlignedVector<T> & JxW){
     if (scalar_vars.size() > 0){
         scalar_vars[0].fill_JxW_values(JxW);
     }
+    else if (scalar_block_vars.size() > 0){
+        scalar_block_vars[0].fill_JxW_values(JxW);
+    }
     else if (vector_vars.size() > 0){
         scalar_change_in_vars[0].fill_JxW_values(JxW);
     }
@@ -99,6 +235,9 @@ unsigned int variableContainer<dim,degree,T>::get_num_q_points(){
     if (scalar_vars.size() > 0){
         return scalar_vars[0].n_q_points;
     }
+    else if (scalar_block_vars.size() > 0){
+        return scalar_block_vars[0].n_q_points;
+    }
     else if (vector_vars.size() > 0){
         return vector_vars[0].n_q_points;
     }
@@ -116,6 +255,9 @@ dealii::Point<dim, T> variableContainer<dim,degree,T>::get_q_point_location(){
     if (scalar_vars.size() > 0){
         return scalar_vars[0].quadrature_point(q_point);
     }
+    else if (scalar_block_vars.size() > 0){
+        return scalar_block_vars[0].quadrature_point(q_point);
+    }
     else if (vector_vars.size() > 0){
         return vector_vars[0].quadrature_point(q_point);
     }
@@ -130,17 +272,52 @@ dealii::Point<dim, T> variableContainer<dim,degree,T>::get_q_point_location(){
 template <int dim, int degree, typename T>
 void variableContainer<dim,degree,T>::reinit_and_eval(const std::vector<vectorType*> &src, unsigned int cell){
 
+    for (unsigned int s=0; s<scalar_steps.size(); s++){
+        const evaluation_step & step = scalar_steps[s];
+        scalar_vars[step.fe_eval_index].reinit(cell);
+        if (step.evaluate){
+            scalar_vars[step.fe_eval_index].read_dof_values(*src[step.var_index]);
+            scalar_vars[step.fe_eval_index].evaluate(step.need_value, step.need_gradient, step.need_hessian);
+        }
+    }
+
+    // Each block is read from the vectors of its variables, starting at its first one
+    for (unsigned int s=0; s<scalar_block_steps.size(); s++){
+        const evaluation_step & step = scalar_block_steps[s];
+        scalar_block_vars[step.fe_eval_index].reinit(cell);
+        if (step.evaluate){
+            scalar_block_vars[step.fe_eval_index].read_dof_values(src, step.var_index);
+            scalar_block_vars[step.fe_eval_index].evaluate(step.need_value, step.need_gradient, step.need_hessian);
+        }
+    }
+
+    for (unsigned int s=0; s<vector_steps.size(); s++){
+        const evaluation_step & step = vector_steps[s];
+        vector_vars[step.fe_eval_index].reinit(cell);
+        if (step.evaluate){
+            vector_vars[step.fe_eval_index].read_dof_values(*src[step.var_index]);
+            vector_vars[step.fe_eval_index].evaluate(step.need_value, step.need_gradient, step.need_hessian);
+        }
+    }
+}
+
+/**
+* Reads the values of the implicit time-dependent variables at the start of the time step. Only the values are evaluated.
+*/
+template <int dim, int degree, typename T>
+void variableContainer<dim,degree,T>::reinit_and_eval_old_solution(const std::vector<vectorType*> &old_src, unsigned int cell){
+
     for (unsigned int i=0; i<num_var; i++){
-        if (varInfoList[i].var_needed){
+        if (varInfoList[i].need_old_value){
             if (varInfoList[i].is_scalar) {
-                scalar_vars[varInfoList[i].scalar_or_vector_index].reinit(cell);
-                scalar_vars[varInfoList[i].scalar_or_vector_index].read_dof_values(*src[i]);
-                scalar_vars[varInfoList[i].scalar_or_vector_index].evaluate(varInfoList[i].need_value, varInfoList[i].need_gradient, varInfoList[i].need_hessian);
+                scalar_old_vars[varInfoList[i].old_scalar_or_vector_index].reinit(cell);
+                scalar_old_vars[varInfoList[i].old_scalar_or_vector_index].read_dof_values(*old_src[i]);
+                scalar_old_vars[varInfoList[i].old_scalar_or_vector_index].evaluate(true, false, false);
             }
             else {
-                vector_vars[varInfoList[i].scalar_or_vector_index].reinit(cell);
-                vector_vars[varInfoList[i].scalar_or_vector_index].read_dof_values(*src[i]);
-                vector_vars[varInfoList[i].scalar_or_vector_index].evaluate(varInfoList[i].need_value, varInfoList[i].need_gradient, varInfoList[i].need_hessian);
+                vector_old_vars[varInfoList[i].old_scalar_or_vector_index].reinit(cell);
+                vector_old_vars[varInfoList[i].old_scalar_or_vector_index].read_dof_values(*old_src[i]);
+                vector_old_vars[varInfoList[i].old_scalar_or_vector_index].evaluate(true, false, false);
             }
         }
     }
@@ -200,235 +377,180 @@ void variableContainer<dim,degree,T>::reinit_and_eval_LHS(const vectorType &src,
 template <int dim, int degree, typename T>
 void variableContainer<dim,degree,T>::reinit(unsigned int cell){
 
-    for (unsigned int i=0; i<num_var; i++){
-        if (varInfoList[i].var_needed){
-            if (varInfoList[i].is_scalar) {
-                scalar_vars[varInfoList[i].scalar_or_vector_index].reinit(cell);
-            }
-            else {
-                vector_vars[varInfoList[i].scalar_or_vector_index].reinit(cell);
-            }
-        }
+    for (unsigned int s=0; s<scalar_steps.size(); s++){
+        scalar_vars[scalar_steps[s].fe_eval_index].reinit(cell);
     }
-}
-
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::integrate_and_distribute(std::vector<vectorType*> &dst){
-
-    for (unsigned int i=0; i<num_var; i++){
-        if (varInfoList[i].value_residual || varInfoList[i].gradient_residual){
-            if (varInfoList[i].is_scalar) {
-                scalar_vars[varInfoList[i].scalar_or_vector_index].integrate(varInfoList[i].value_residual, varInfoList[i].gradient_residual);
-                scalar_vars[varInfoList[i].scalar_or_vector_index].distribute_local_to_global(*dst[i]);
-            }
-            else {
-                vector_vars[varInfoList[i].scalar_or_vector_index].integrate(varInfoList[i].value_residual, varInfoList[i].gradient_residual);
-                vector_vars[varInfoList[i].scalar_or_vector_index].distribute_local_to_global(*dst[i]);
-            }
-        }
+    for (unsigned int s=0; s<scalar_block_steps.size(); s++){
+        scalar_block_vars[scalar_block_steps[s].fe_eval_index].reinit(cell);
+    }
+    for (unsigned int s=0; s<vector_steps.size(); s++){
+        vector_vars[vector_steps[s].fe_eval_index].reinit(cell);
     }
 }
 
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::integrate_and_distribute_change_in_solution_LHS(vectorType &dst, const unsigned int var_being_solved){
 
-    //integrate
+template <int dim, int degree, typename T>
+unsigned int variableContainer<dim,degree,T>::get_num_change_in_solution_dofs(const unsigned int var_being_solved) const{
     if (varChangeInfoList[var_being_solved].is_scalar) {
-    	scalar_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
-    	scalar_change_in_vars[0].distribute_local_to_global(dst);
+        return scalar_change_in_vars[0].tensor_dofs_per_cell;
     }
     else {
-        vector_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
-    	vector_change_in_vars[0].distribute_local_to_global(dst);
+        return vector_change_in_vars[0].tensor_dofs_per_cell*dim;
     }
 }
 
-// Need to add index checking to these functions so that an error is thrown if the index wasn't set
 template <int dim, int degree, typename T>
-T variableContainer<dim,degree,T>::get_scalar_value(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_value){
-        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+void variableContainer<dim,degree,T>::reinit_change_in_solution(unsigned int cell, const unsigned int var_being_solved){
+    if (varChangeInfoList[var_being_solved].is_scalar) {
+        scalar_change_in_vars[0].reinit(cell);
     }
     else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+        vector_change_in_vars[0].reinit(cell);
     }
 }
 
+/**
+* Sets the local change in the solution to one for a single DOF (and zero for the rest) and evaluates it. Together
+* with integrate_change_in_solution_LHS_entry, this gives one diagonal entry of the LHS for each lane of the cell batch.
+*/
 template <int dim, int degree, typename T>
-dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_scalar_gradient(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_gradient){
-        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
-    }
-}
+void variableContainer<dim,degree,T>::eval_change_in_solution_unit_vector(const unsigned int dof_index, const unsigned int var_being_solved){
+    unsigned int num_dofs = get_num_change_in_solution_dofs(var_being_solved);
 
-template <int dim, int degree, typename T>
-dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_scalar_hessian(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_hessian){
-        return scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+    if (varChangeInfoList[var_being_solved].is_scalar) {
+        for (unsigned int i=0; i<num_dofs; i++){
+            scalar_change_in_vars[0].begin_dof_values()[i] = dealii::make_vectorized_array(0.0);
+        }
+        scalar_change_in_vars[0].begin_dof_values()[dof_index] = dealii::make_vectorized_array(1.0);
+        scalar_change_in_vars[0].evaluate(varChangeInfoList[var_being_solved].need_value, varChangeInfoList[var_being_solved].need_gradient, varChangeInfoList[var_being_solved].need_hessian);
     }
     else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+        for (unsigned int i=0; i<num_dofs; i++){
+            vector_change_in_vars[0].begin_dof_values()[i] = dealii::make_vectorized_array(0.0);
+        }
+        vector_change_in_vars[0].begin_dof_values()[dof_index] = dealii::make_vectorized_array(1.0);
+        vector_change_in_vars[0].evaluate(varChangeInfoList[var_being_solved].need_value, varChangeInfoList[var_being_solved].need_gradient, varChangeInfoList[var_being_solved].need_hessian);
     }
 }
 
 template <int dim, int degree, typename T>
-dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_vector_value(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_value){
-        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+T variableContainer<dim,degree,T>::integrate_change_in_solution_LHS_entry(const unsigned int dof_index, const unsigned int var_being_solved){
+    if (varChangeInfoList[var_being_solved].is_scalar) {
+        scalar_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
+        return scalar_change_in_vars[0].begin_dof_values()[dof_index];
     }
     else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+        vector_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
+        return vector_change_in_vars[0].begin_dof_values()[dof_index];
     }
 }
 
 template <int dim, int degree, typename T>
-dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_vector_gradient(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_gradient){
-        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
+void variableContainer<dim,degree,T>::distribute_change_in_solution_local_vector(const dealii::AlignedVector<T> &local_vector, vectorType &dst, const unsigned int var_being_solved){
+    if (varChangeInfoList[var_being_solved].is_scalar) {
+        for (unsigned int i=0; i<local_vector.size(); i++){
+            scalar_change_in_vars[0].begin_dof_values()[i] = local_vector[i];
+        }
+        scalar_change_in_vars[0].distribute_local_to_global(dst);
     }
     else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+        for (unsigned int i=0; i<local_vector.size(); i++){
+            vector_change_in_vars[0].begin_dof_values()[i] = local_vector[i];
+        }
+        vector_change_in_vars[0].distribute_local_to_global(dst);
     }
 }
 
 template <int dim, int degree, typename T>
-dealii::Tensor<3, dim, T > variableContainer<dim,degree,T>::get_vector_hessian(unsigned int global_variable_index) const
-{
-    if (varInfoList[global_variable_index].need_hessian){
-        return vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
-    }
-}
+void variableContainer<dim,degree,T>::integrate_and_distribute(std::vector<vectorType*> &dst, const double residual_scale){
 
-// Need to add index checking to these functions so that an error is thrown if the index wasn't set
-template <int dim, int degree, typename T>
-T variableContainer<dim,degree,T>::get_change_in_scalar_value(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_value){
-        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+    for (unsigned int s=0; s<scalar_steps.size(); s++){
+        const evaluation_step & step = scalar_steps[s];
+        if (step.integrate){
+            scalar_vars[step.fe_eval_index].integrate(step.value_residual, step.gradient_residual);
+            if (residual_scale != 1.0){
+                scale_dof_values(scalar_vars[step.fe_eval_index], residual_scale);
+            }
+            scalar_vars[step.fe_eval_index].distribute_local_to_global(*dst[step.var_index]);
+        }
     }
-}
 
-template <int dim, int degree, typename T>
-dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_change_in_scalar_gradient(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_gradient){
-        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+    // The residuals of each block are distributed to the vectors of its variables, starting at its first one
+    for (unsigned int s=0; s<scalar_block_steps.size(); s++){
+        const evaluation_step & step = scalar_block_steps[s];
+        if (step.integrate){
+            scalar_block_vars[step.fe_eval_index].integrate(step.value_residual, step.gradient_residual);
+            if (residual_scale != 1.0){
+                scale_dof_values(scalar_block_vars[step.fe_eval_index], residual_scale);
+            }
+            scalar_block_vars[step.fe_eval_index].distribute_local_to_global(dst, step.var_index);
+        }
     }
-}
 
-template <int dim, int degree, typename T>
-dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_change_in_scalar_hessian(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_hessian){
-        return scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+    for (unsigned int s=0; s<vector_steps.size(); s++){
+        const evaluation_step & step = vector_steps[s];
+        if (step.integrate){
+            vector_vars[step.fe_eval_index].integrate(step.value_residual, step.gradient_residual);
+            if (residual_scale != 1.0){
+                scale_dof_values(vector_vars[step.fe_eval_index], residual_scale);
+            }
+            vector_vars[step.fe_eval_index].distribute_local_to_global(*dst[step.var_index]);
+        }
     }
 }
 
+// The local DOF values of all of the components are stored one after the other
 template <int dim, int degree, typename T>
-dealii::Tensor<1, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_value(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_value){
-        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_value(q_point);
+template <typename FEEvaluationType>
+void variableContainer<dim,degree,T>::scale_dof_values(FEEvaluationType &fe_eval, const double scale) const {
+    unsigned int n_dof_values = FEEvaluationType::n_components;
+    for (unsigned int d=0; d<dim; d++){
+        n_dof_values *= (degree+1);
     }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+
+    dealii::VectorizedArray<double> * dof_values = fe_eval.begin_dof_values();
+    for (unsigned int i=0; i<n_dof_values; i++){
+        dof_values[i] = scale*dof_values[i];
     }
 }
 
+/**
+* Integrates the residual of a single variable and distributes it to its own vector (used when the RHS of one
+* nonexplicit equation is calculated on its own).
+*/
 template <int dim, int degree, typename T>
-dealii::Tensor<2, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_gradient(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_gradient){
-        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_gradient(q_point);
-    }
-    else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+void variableContainer<dim,degree,T>::integrate_and_distribute(vectorType &dst, const unsigned int var_index){
+
+    if (varInfoList[var_index].value_residual || varInfoList[var_index].gradient_residual){
+        if (var_block_index[var_index] >= 0) {
+            std::cerr << "PRISMS-PF Error: The residual of a variable evaluated in a block can't be distributed on its own." << std::endl;
+            abort();
+        }
+        else if (varInfoList[var_index].is_scalar) {
+            scalar_vars[varInfoList[var_index].scalar_or_vector_index].integrate(varInfoList[var_index].value_residual, varInfoList[var_index].gradient_residual);
+            scalar_vars[varInfoList[var_index].scalar_or_vector_index].distribute_local_to_global(dst);
+        }
+        else {
+            vector_vars[varInfoList[var_index].scalar_or_vector_index].integrate(varInfoList[var_index].value_residual, varInfoList[var_index].gradient_residual);
+            vector_vars[varInfoList[var_index].scalar_or_vector_index].distribute_local_to_global(dst);
+        }
     }
 }
 
 template <int dim, int degree, typename T>
-dealii::Tensor<3, dim, T > variableContainer<dim,degree,T>::get_change_in_vector_hessian(unsigned int global_variable_index) const
-{
-    if (varChangeInfoList[global_variable_index].need_hessian){
-        return vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].get_hessian(q_point);
+void variableContainer<dim,degree,T>::integrate_and_distribute_change_in_solution_LHS(vectorType &dst, const unsigned int var_being_solved){
+
+    //integrate
+    if (varChangeInfoList[var_being_solved].is_scalar) {
+    	scalar_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
+    	scalar_change_in_vars[0].distribute_local_to_global(dst);
     }
     else {
-        std::cerr << "PRISMS-PF Error: Attempted access of a variable value that was not marked as needed in 'parameters.in'. Double-check the indices in user functions where a variable value is requested." << std::endl;
-        abort();
+        vector_change_in_vars[0].integrate(varChangeInfoList[var_being_solved].value_residual, varChangeInfoList[var_being_solved].gradient_residual);
+    	vector_change_in_vars[0].distribute_local_to_global(dst);
     }
 }
 
-// The methods to set the residual terms
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_scalar_value_term_RHS(unsigned int global_variable_index, T val){
-    scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
-}
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_scalar_gradient_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > grad){
-    scalar_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
-}
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_vector_value_term_RHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > val){
-    vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
-}
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_vector_gradient_term_RHS(unsigned int global_variable_index, dealii::Tensor<2, dim, T > grad){
-    vector_vars[varInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
-}
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_scalar_value_term_LHS(unsigned int global_variable_index, T val){
-    scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
-}
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_scalar_gradient_term_LHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > grad){
-    scalar_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
-}
-
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_vector_value_term_LHS(unsigned int global_variable_index, dealii::Tensor<1, dim, T > val){
-    vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_value(val,q_point);
-}
-template <int dim, int degree, typename T>
-void variableContainer<dim,degree,T>::set_vector_gradient_term_LHS(unsigned int global_variable_index, dealii::Tensor<2, dim, T > grad){
-    vector_change_in_vars[varChangeInfoList[global_variable_index].scalar_or_vector_index].submit_gradient(grad,q_point);
-}
-
 template class variableContainer<2,1,dealii::VectorizedArray<double> >;
 template class variableContainer<2,2,dealii::VectorizedArray<double> >;
 template class variableContainer<2,3,dealii::VectorizedArray<double> >;
@@ -257,6 +257,18 @@ bool unitTest<dim,T>::test_EquationDependencyParser_variables_and_residuals_need
     std::cout << "Subtest " << subtest_index << " result for 'need_gradient_residual_nonexplicit_LHS': " << result << std::endl;
     pass = pass && result;
 
+    // Check eq_need_value_nonexplicit_RHS (the flags for each equation on its own)
+    subtest_index++;
+    result = false;
+    if (equation_dependency_parser.eq_need_value_nonexplicit_RHS.size() == 2){
+        if (equation_dependency_parser.eq_need_value_nonexplicit_RHS[0][0] == false && equation_dependency_parser.eq_need_value_nonexplicit_RHS[0][1] == false
+            && equation_dependency_parser.eq_need_value_nonexplicit_RHS[1][0] == true && equation_dependency_parser.eq_need_value_nonexplicit_RHS[1][1] == false){
+            result = true;
+        }
+    }
+    std::cout << "Subtest " << subtest_index << " result for 'eq_need_value_nonexplicit_RHS': " << result << std::endl;
+    pass = pass && result;
+
 
 
     sprintf (buffer, "Test result for 'EquationDependencyParser': %u\n", pass);
@@ -284,6 +296,7 @@ bool unitTest<dim,T>::test_EquationDependencyParser_nonlinear(){
     var_name.push_back("def");
     var_name.push_back("ghij");
     var_name.push_back("klmno");
+    var_name.push_back("pq");
 
     std::vector<PDEType> var_eq_type;
     var_eq_type.push_back(EXPLICIT_TIME_DEPENDENT); // Not nonlinear by definition
@@ -291,6 +304,7 @@ bool unitTest<dim,T>::test_EquationDependencyParser_nonlinear(){
     var_eq_type.push_back(TIME_INDEPENDENT);  // Crafted to be nonlinear due to LHS (due to needed non-change version of governing variable)
     var_eq_type.push_back(TIME_INDEPENDENT);  // Crafted to be nonlinear due to LHS (due to needing a non-governing variable)
     var_eq_type.push_back(TIME_INDEPENDENT);  // Crafted to be linear
+    var_eq_type.push_back(IMPLICIT_TIME_DEPENDENT);  // Crafted to be linear (the old value doesn't add a nonlinearity)
 
 
     // Populate the dependency strings
@@ -299,24 +313,28 @@ bool unitTest<dim,T>::test_EquationDependencyParser_nonlinear(){
     sorted_dependencies_value_RHS.push_back("def");
     sorted_dependencies_value_RHS.push_back("a, ghij");
     sorted_dependencies_value_RHS.push_back("a, klmno");
+    sorted_dependencies_value_RHS.push_back("pq, old(pq)");
 
     sorted_dependencies_gradient_RHS.push_back("hess(def), ghij");
     sorted_dependencies_gradient_RHS.push_back("grad(bc)");
     sorted_dependencies_gradient_RHS.push_back("");
     sorted_dependencies_gradient_RHS.push_back("grad(ghij)");
     sorted_dependencies_gradient_RHS.push_back("grad(klmno)");
+    sorted_dependencies_gradient_RHS.push_back("grad(pq)");
 
     sorted_dependencies_value_LHS.push_back("");
     sorted_dependencies_value_LHS.push_back("change(bc)");
     sorted_dependencies_value_LHS.push_back("change(def)");
     sorted_dependencies_value_LHS.push_back("change(ghij), grad(def)");
     sorted_dependencies_value_LHS.push_back("change(klmno), grad(a)");
+    sorted_dependencies_value_LHS.push_back("change(pq)");
 
     sorted_dependencies_gradient_LHS.push_back("");
     sorted_dependencies_gradient_LHS.push_back("");
     sorted_dependencies_gradient_LHS.push_back("grad(def)");
     sorted_dependencies_gradient_LHS.push_back("");
     sorted_dependencies_gradient_LHS.push_back("hess(change(klmno))");
+    sorted_dependencies_gradient_LHS.push_back("grad(change(pq))");
 
     std::vector<bool> var_nonlinear;
 
@@ -380,6 +398,15 @@ bool unitTest<dim,T>::test_EquationDependencyParser_nonlinear(){
     std::cout << "Subtest " << subtest_index << " result for linear time independent: " << result << std::endl;
     pass = pass && result;
 
+    // Check linear implicit time dependent equation that uses the old value of its variable
+    subtest_index++;
+    result = false;
+    if (var_nonlinear[5] == false && equation_dependency_parser.need_value_old_nonexplicit_RHS[5] == true && equation_dependency_parser.need_value_old_nonexplicit_RHS[4] == false){
+            result = true;
+    }
+    std::cout << "Subtest " << subtest_index << " result for linear implicit time dependent with an old value: " << result << std::endl;
+    pass = pass && result;
+
 
 
     sprintf (buffer, "Test result for 'EquationDependencyParser': %u\n", pass);
@@ -12,7 +12,7 @@ template <int dim,typename T>
     LinearSolverParameters test_object;
 
     test_object.loadParameters(2,ABSOLUTE_RESIDUAL,1.0e-3,123);
-    test_object.loadParameters(5,RELATIVE_RESIDUAL_CHANGE,1.0e-4,124);
+    test_object.loadParameters(5,RELATIVE_RESIDUAL_CHANGE,1.0e-4,124,CHEBYSHEV,4,30.0,QUADRATIC_EXTRAPOLATION,1,0.0,SINGLE_PRECISION);
 
     // Subtests
     unsigned int subtest_index = 0;
@@ -47,6 +47,36 @@ template <int dim,typename T>
     }
     std::cout << "Subtest " << subtest_index << " result for 'getToleranceValue': " << result << std::endl;
 
+    pass = pass && result;
+
+    //Subtest 4
+    subtest_index++;
+    result = false;
+    if (test_object.getPreconditionerType(2) == NO_PRECONDITIONER && test_object.getPreconditionerType(5) == CHEBYSHEV && test_object.getChebyshevDegree(5) == 4 && std::abs(test_object.getChebyshevSmoothingRange(5) - 30.0) < 1.0e-12){
+        result = true;
+    }
+    std::cout << "Subtest " << subtest_index << " result for the preconditioner parameters: " << result << std::endl;
+
+    pass = pass && result;
+
+    //Subtest 5
+    subtest_index++;
+    result = false;
+    if (test_object.getInitialGuessType(2) == ZERO_INITIAL_GUESS && test_object.getInitialGuessType(5) == QUADRATIC_EXTRAPOLATION){
+        result = true;
+    }
+    std::cout << "Subtest " << subtest_index << " result for 'getInitialGuessType': " << result << std::endl;
+
+    pass = pass && result;
+
+    //Subtest 6
+    subtest_index++;
+    result = false;
+    if (test_object.getPreconditionerPrecision(2) == DOUBLE_PRECISION && test_object.getPreconditionerPrecision(5) == SINGLE_PRECISION){
+        result = true;
+    }
+    std::cout << "Subtest " << subtest_index << " result for 'getPreconditionerPrecision': " << result << std::endl;
+
     pass = pass && result;
 
 
@@ -13,7 +13,7 @@ template <int dim,typename T>
 
     test_object.setMaxIterations(123);
     test_object.loadParameters(2,ABSOLUTE_RESIDUAL,1.0e-3,true,0.5,1.0,1.0,false);
-    test_object.loadParameters(5,RELATIVE_RESIDUAL_CHANGE,1.0e-4,false,0.5,1.0,0.5,false);
+    test_object.loadParameters(5,RELATIVE_RESIDUAL_CHANGE,1.0e-4,false,0.5,1.0,0.5,false,NEWTON_KRYLOV,0.2,0.8,1.0e-3,3);
 
     // Subtests
     unsigned int subtest_index = 0;
@@ -68,6 +68,18 @@ template <int dim,typename T>
     }
     std::cout << "Subtest " << subtest_index << " result for 'getDefaultDampingCoefficient': " << result << std::endl;
 
+    pass = pass && result;
+
+    //Subtest 6
+    subtest_index++;
+    result = false;
+    if (test_object.getSolverType(2) == DAMPED_ITERATION && test_object.getSolverType(5) == NEWTON_KRYLOV
+        && std::abs(test_object.getInitialForcingTerm(5) - 0.2) < 1.0e-12 && std::abs(test_object.getMaxForcingTerm(5) - 0.8) < 1.0e-12
+        && std::abs(test_object.getArmijoCoeff(5) - 1.0e-3) < 1.0e-12 && test_object.getAndersonDepth(2) == 0 && test_object.getAndersonDepth(5) == 3){
+        result = true;
+    }
+    std::cout << "Subtest " << subtest_index << " result for the Newton-Krylov and Anderson acceleration parameters: " << result << std::endl;
+
     pass = pass && result;
 
 	sprintf (buffer, "Test result for 'NonlinearSolverParameters': %u\n", pass);
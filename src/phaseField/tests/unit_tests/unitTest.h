@@ -36,9 +36,14 @@ void computeStress(const dealii::Table<2, double>& CIJ, const dealii::Vectorized
 #include "../../src/matrixfree/refine.cc"
 #include "../../src/matrixfree/invM.cc"
 #include "../../src/matrixfree/computeLHS.cc"
+#include "../../src/matrixfree/preconditioner.cc"
+#include "../../src/matrixfree/multigrid.cc"
 #include "../../src/matrixfree/computeRHS.cc"
 #include "../../src/matrixfree/solve.cc"
 #include "../../src/matrixfree/solveIncrement.cc"
+#include "../../src/matrixfree/adaptiveTimeStep.cc"
+#include "../../src/matrixfree/localTimeStepping.cc"
+#include "../../src/matrixfree/explicitSubcycling.cc"
 #include "../../src/matrixfree/outputResults.cc"
 #include "../../src/matrixfree/markBoundaries.cc"
 #include "../../src/matrixfree/boundaryConditions.cc"